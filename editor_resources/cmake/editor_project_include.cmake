@@ -0,0 +1,39 @@
+# This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+# Copyright (C) 2023-2025  Ryan Zmuda
+#
+# Licensed under the MIT license. See LICENSE file in the project root for details.
+
+#
+# Injected into game builds by the editor through CMAKE_PROJECT_INCLUDE, so it
+# runs right after every project() call. The game's targets do not exist yet
+# at that point, the settings are applied once the top level CMakeLists.txt is
+# done. Only the game's own executables are touched, the engine is built as is.
+#
+#   YOYO_EDITOR_UNITY_BUILD   compile the game's sources as unity (jumbo) batches
+#   YOYO_EDITOR_PCH           precompile yoyoengine/yoyoengine.h for the game
+#
+
+# nested projects (the engine) run this too, only the game's project counts
+if(NOT CMAKE_CURRENT_SOURCE_DIR STREQUAL CMAKE_SOURCE_DIR)
+    return()
+endif()
+include_guard(GLOBAL)
+
+function(_yoyo_editor_apply_build_options)
+    get_property(targets DIRECTORY "${CMAKE_SOURCE_DIR}" PROPERTY BUILDSYSTEM_TARGETS)
+    foreach(target IN LISTS targets)
+        get_target_property(type ${target} TYPE)
+        if(NOT type STREQUAL "EXECUTABLE")
+            continue()
+        endif()
+
+        if(YOYO_EDITOR_UNITY_BUILD)
+            set_target_properties(${target} PROPERTIES UNITY_BUILD ON UNITY_BUILD_BATCH_SIZE 16)
+        endif()
+        if(YOYO_EDITOR_PCH)
+            target_precompile_headers(${target} PRIVATE <yoyoengine/yoyoengine.h>)
+        endif()
+    endforeach()
+endfunction()
+
+cmake_language(DEFER DIRECTORY "${CMAKE_SOURCE_DIR}" CALL _yoyo_editor_apply_build_options)
@@ -73,12 +73,15 @@ struct editor_state {
     bool is_building;
     SDL_Thread *building_thread;
     SDL_Mutex *build_mutex;
-    int build_status; // 0 = running, 1 = done, 2 = error
+    int build_status; // 0 = running, 1 = done, 2 = error, 3 = cancelled
     char build_status_msg[256];
+    float build_progress; // 0.0 - 1.0, written by the build thread under build_mutex
+    Uint64 build_start_ticks;
+    bool build_should_run; // launch the game (from the main thread) once the build succeeds
 
     // game running //
     bool is_running;
-    int running_thread;
+    SDL_Thread *running_thread; // supervisor of the running game, see editor_game.h
     // TODO: pipes for IPC :eyes:
 };
 
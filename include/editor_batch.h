@@ -0,0 +1,105 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_BATCH_H
+#define EDITOR_BATCH_H
+
+/*
+    Batch build of several projects from the welcome screen.
+
+    Every selected project is packed and built (whatever its build.yoyo
+    selects) without being opened. A few projects run at once and share one
+    budget of compile jobs, the rest wait in a queue. Everything here lives
+    on the main thread, the workers are the usual pack and build jobs.
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_pack.h"
+
+#define EDITOR_BATCH_MAX 32
+
+enum editor_batch_status {
+    EDITOR_BATCH_QUEUED,
+    EDITOR_BATCH_RUNNING,
+    EDITOR_BATCH_DONE,
+    EDITOR_BATCH_FAILED,
+    EDITOR_BATCH_CANCELLED
+};
+
+struct editor_build_job;
+
+struct editor_batch_project {
+    char name[128];
+    char path[1024];
+    enum editor_batch_status status;
+    char message[256];
+
+    struct editor_build_job *job;   // kept after it finishes for its log, NULL if it could not be prepared
+    struct editor_pack_job packs[EDITOR_PACK_NUM_JOBS];
+    bool packs_done;
+
+    // timings, filled in as the steps finish
+    Uint64 start_ticks;
+    float pack_seconds;     // the slower of the two packs, they run alongside the compile
+    float configure_seconds;
+    float compile_seconds;
+    float total_seconds;
+    int parallel_jobs;
+};
+
+struct editor_batch_state {
+    struct editor_batch_project projects[EDITOR_BATCH_MAX];
+    int num_projects;
+
+    int max_parallel;       // projects built at once
+    int job_budget;         // compile jobs split between the running projects
+    bool force_pack;
+
+    bool running;
+    Uint64 start_ticks;
+    Uint64 end_ticks;
+};
+
+extern struct editor_batch_state editor_batch;
+
+void editor_batch_init();
+
+void editor_batch_shutdown();
+
+/**
+ * @brief Queues a batch build of the given projects (results of the previous
+ * batch are dropped). Duplicate paths are skipped.
+ */
+bool editor_batch_start(const char **names, const char **paths, int count);
+
+/**
+ * @brief Cancels the running builds and drops the queued ones. Packs cannot be
+ * interrupted, they are reaped once they finish.
+ */
+void editor_batch_cancel();
+
+/**
+ * @brief Cancels (and waits for) a batch build writing into build_dir, so an
+ * interactive build of the same tree can take over.
+ */
+void editor_batch_cancel_build_dir(const char *build_dir);
+
+/**
+ * @brief Blocks until the batch packs of project_root are done, so the editor
+ * can pack the same files itself. Main thread only.
+ */
+void editor_batch_wait_project_packs(const char *project_root);
+
+/**
+ * @brief Reaps finished projects and starts queued ones, call once per frame.
+ */
+void editor_batch_poll();
+
+#endif // EDITOR_BATCH_H
@@ -9,16 +9,193 @@
 #define YE_EDITOR_BUILD_H
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include "editor_log.h"
+
+#define EDITOR_BUILD_LOG_LINES 4096
+#define EDITOR_BUILD_MAX_DIAGNOSTICS 256
+
+/*
+    An error or warning parsed out of the build output
+*/
+struct editor_build_diagnostic {
+    bool is_error;
+    int line;
+    int column; // 0 if not reported
+    char file[512];
+    char message[512];
+};
+
+#define EDITOR_BUILD_HISTORY_MAX 50
+
+/*
+    Frame time statistics of a headless benchmark run of one build, in
+    milliseconds. Kept in the build history, the runner that fills it in
+    needs a benchmark mode in the engine first
+*/
+struct editor_build_benchmark {
+    bool valid;             // false if the build was never benchmarked
+    char scene[256];
+    int frames;
+    float p50;
+    float p95;
+    float p99;
+    float max;
+};
+
+/*
+    Wall time of each step of one build, in seconds (0 if a step did not run)
+*/
+struct editor_build_timing {
+    Sint64 timestamp;       // unix time the build finished
+    char config[64];        // build dir name, see editor_active_build_dir()
+    int result;             // final build_status (1 = done, 2 = error, 3 = cancelled)
+    float pack_engine;
+    float pack_resources;
+    float configure;
+    float compile;
+    float launch;
+    float total;
+    bool unity_build;       // compile speedups the build was configured with
+    bool precompiled_header;
+    struct editor_build_benchmark benchmark; // latest benchmark of this build
+};
+
+/*
+    Recent builds of the open project, oldest first. Persisted under build/,
+    where the configure fingerprint (editor_build_job.c) does not look
+*/
+#define EDITOR_BUILD_HISTORY_FILE "build/build_history.yoyo"
+
+extern struct editor_build_timing editor_build_history[EDITOR_BUILD_HISTORY_MAX];
+extern int editor_build_history_count;
+
+/**
+ * @brief Loads build_history.yoyo for the open project, if not already loaded.
+ */
+void editor_build_history_load();
+
+/**
+ * @brief Compares the compile time of the latest full build (one that configured
+ * its tree) against the latest full build of the same platform and mode that had
+ * unity builds/precompiled headers the other way around.
+ *
+ * @return false if the history has no such pair yet
+ */
+bool editor_build_compile_delta(float *with, float *without);
+
+/*
+    Compiler cache hits/misses of the last compile step,
+    guarded by EDITOR_STATE.build_mutex while a build is running
+*/
+struct editor_build_cache_stats {
+    bool valid; // false if no cache is configured or its stats could not be read
+    long hits;
+    long misses;
+};
+
+extern struct editor_build_cache_stats editor_build_cache_stats;
+
+// captured output of the last build
+extern struct editor_log_ring editor_build_log;
+
+// guarded by EDITOR_STATE.build_mutex while a build is running
+extern struct editor_build_diagnostic editor_build_diagnostics[EDITOR_BUILD_MAX_DIAGNOSTICS];
+extern int editor_build_num_diagnostics;
+
+void editor_build_init();
+
+void editor_build_shutdown();
 
 void editor_build_packs(bool force);
 
-// main handler for building the project, others are wrappers directed to this
+/*
+    main handler for building the project, others are wrappers directed to this.
+    Requests made while a build is running cancel it and are coalesced into
+    one follow-up build.
+*/
 void editor_build(bool force_configure, bool should_run);
 
+/**
+ * @brief Cancels the running build (killing its whole process tree) and drops any queued one.
+ */
+void editor_build_cancel();
+
+/*
+    Called once per frame from the editing loop, picks up a finished
+    background build (join thread, notify, optionally run the game)
+*/
+void editor_build_poll();
+
 void editor_build_and_run();
 
+/**
+ * @brief Resolves the build directory of the configuration currently selected
+ * in build.yoyo (build/<platform>-<mode>-<hash>).
+ */
+bool editor_active_build_dir(char *out, size_t size);
+
+/**
+ * @brief Resolves the path of the built game executable (honoring the
+ * executable_path override in build.yoyo). Does not check that it exists.
+ */
+bool editor_resolve_executable(char *exe_path, size_t size);
+
+/**
+ * @brief Environment the game is launched with. Free with SDL_DestroyEnvironment().
+ */
+SDL_Environment * editor_run_environment();
+
+/**
+ * @brief True if the selected configuration is a gprof profiling build (build.yoyo "profiling").
+ */
+bool editor_build_profiling_enabled();
+
 void editor_run();
 
 void editor_build_reconfigure();
 
+/*
+    One build configuration, empty fields fall back to what build.yoyo selects
+*/
+struct editor_build_config {
+    char platform[32];      // "linux" | "windows" | "emscripten"
+    char build_mode[16];    // "Debug" | "Release"
+};
+
+#define EDITOR_BUILD_MATRIX_MAX 8
+
+struct editor_build_job;
+
+/*
+    Jobs of the last build matrix run, kept after they finish so their
+    status and logs can still be inspected
+*/
+extern struct editor_build_job *editor_build_matrix_jobs[EDITOR_BUILD_MATRIX_MAX];
+extern int editor_build_matrix_count;
+
+/**
+ * @brief Builds several configurations concurrently, each in its own build tree.
+ * The machine's cores are split evenly between the jobs. Configurations that map
+ * to the tree the interactive build is using are skipped.
+ */
+bool editor_build_matrix_start(const struct editor_build_config *configs, int count);
+
+/**
+ * @brief Cancels every running matrix job.
+ */
+void editor_build_matrix_cancel();
+
+bool editor_build_matrix_running();
+
+/**
+ * @brief Prepares a non-interactive build job for a project other than the
+ * opened one, building what its build.yoyo selects (never PGO or profiling).
+ * Must be called from the main thread. Start it with editor_build_job_start().
+ *
+ * @return the job, or NULL if the project's settings could not be read
+ */
+struct editor_build_job * editor_build_prepare_project_job(const char *project_root);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,117 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_BUILD_JOB_H
+#define EDITOR_BUILD_JOB_H
+
+/*
+    Build executor.
+
+    A job configures (if needed) and compiles one build tree on its own
+    thread, streaming the output into a log ring. Jobs only ever use
+    absolute paths and never change the working directory, so several can
+    run at once as long as they target different build trees.
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_log.h"
+
+// memory budgeted per compile job when picking the parallelism
+#define EDITOR_BUILD_JOB_MB 1024
+
+// configure arg pointing FetchContent at the shared engine source
+#define EDITOR_ENGINE_SOURCE_ARG "-DFETCHCONTENT_SOURCE_DIR_YOYOENGINE="
+
+struct editor_build_job {
+    /*
+        Configuration, filled in on the main thread before the job starts.
+        ye_path() hands out a static buffer the editor keeps using every
+        frame, so every path is resolved up front.
+    */
+    char label[64];         // shown in the UI, e.g. "linux-debug"
+    bool interactive;       // the editor's main build: mirrors status into EDITOR_STATE and fills the diagnostics list
+    bool force_configure;
+    bool wait_for_packs;    // hold the "done" status until running pack jobs finish
+    bool pgo;               // instrument, train and rebuild optimized, see build_job_pgo()
+    int pgo_seconds;        // length of the training run
+    bool unity_build;       // recorded in the build history, the flags themselves are in configure_argv
+    bool precompiled_header;
+    int max_jobs;           // user cap on compile jobs (build.yoyo "max_jobs"), 0 = no cap
+    int job_share;          // number of jobs splitting the machine between them, 1 for a lone build
+
+    char project_root[1024];
+    char build_dir[1024];
+    char cmake_cache_path[1024];
+    char build_file_path[1024];
+    char fingerprint_path[1024];
+    char exe_path[512];
+    char **configure_argv;  // full cmake configure command line, owned by the job
+    char engine_cache_dir[1024]; // shared engine source for the engine tag, "" if it is not cached
+
+    // compiler cache tool ("" for none) and its size limit ("" for the tool default)
+    char compiler_cache[16];
+    char compiler_cache_size[32];
+
+    struct editor_log_ring *log;    // editor_build_log for interactive jobs, own_log otherwise
+    struct editor_log_ring own_log;
+
+    /*
+        Runtime state, guarded by EDITOR_STATE.build_mutex
+    */
+    int status;             // 0 = running, 1 = done, 2 = error, 3 = cancelled
+    float progress;         // 0.0 - 1.0
+    char status_msg[256];
+    int num_errors;
+    int num_warnings;
+    SDL_Process *process;   // child currently running, if any
+
+    /*
+        Worker side
+    */
+    SDL_Thread *thread;
+    SDL_AtomicInt cancel;
+    SDL_Environment *env;   // environment for child processes, NULL to inherit ours
+    float progress_base;    // progress window of the step currently running
+    float progress_span;
+    int parallel_jobs;      // compile jobs picked when the compile step starts
+
+    // timings, valid once the job has finished
+    Uint64 start_ticks;
+    Uint64 end_ticks;
+    float configure_seconds;
+    float compile_seconds;
+};
+
+/**
+ * @brief Allocates an empty job. Non interactive jobs get their own log ring.
+ */
+struct editor_build_job * editor_build_job_create(bool interactive);
+
+/**
+ * @brief Launches the job's worker thread, returns false if it could not be created.
+ */
+bool editor_build_job_start(struct editor_build_job *job);
+
+/**
+ * @brief Thread safe read of the job status (0 = running, 1 = done, 2 = error, 3 = cancelled).
+ */
+int editor_build_job_status(struct editor_build_job *job);
+
+/**
+ * @brief Requests cancellation and kills the job's whole process tree.
+ */
+void editor_build_job_cancel(struct editor_build_job *job);
+
+/**
+ * @brief Joins the worker (if any) and frees the job.
+ */
+void editor_build_job_destroy(struct editor_build_job *job);
+
+#endif // EDITOR_BUILD_JOB_H
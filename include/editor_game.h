@@ -0,0 +1,84 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_GAME_H
+#define EDITOR_GAME_H
+
+/*
+    Supervisor for the game process launched by editor_run().
+
+    A worker thread owns the process: it drains the game's output into
+    editor_game_log, samples its CPU usage, resident memory and thread count
+    a few times a second (from /proc, Linux only) and records how it exited.
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_log.h"
+
+#define EDITOR_GAME_LOG_LINES 4096
+
+// one sample every EDITOR_GAME_SAMPLE_MS, the history covers the last minute
+#define EDITOR_GAME_SAMPLE_MS 250
+#define EDITOR_GAME_MAX_SAMPLES 240
+
+struct editor_game_sample {
+    float seconds;      // since launch
+    float cpu_percent;  // of one core, so a busy game can go past 100
+    float rss_mb;
+    int threads;
+};
+
+/*
+    Everything below is guarded by editor_game_lock()/editor_game_unlock()
+*/
+struct editor_game_state {
+    bool launched;      // a game was started this session
+    bool running;
+    bool can_sample;    // false where process stats are not available
+    Sint64 pid;
+    int exit_code;
+    Uint64 start_ticks;
+    Uint64 end_ticks;
+
+    struct editor_game_sample samples[EDITOR_GAME_MAX_SAMPLES];
+    int num_samples;    // oldest sample first
+};
+
+extern struct editor_game_state editor_game;
+
+// stdout/stderr of the game
+extern struct editor_log_ring editor_game_log;
+
+void editor_game_init();
+
+void editor_game_shutdown();
+
+/**
+ * @brief Takes ownership of a freshly launched game process (started with its
+ * stdout piped to the app). A game that is still running is killed first.
+ */
+void editor_game_attach(SDL_Process *proc);
+
+/**
+ * @brief Asks the running game to quit.
+ *
+ * @param force kill it outright instead of letting it exit cleanly
+ */
+void editor_game_stop(bool force);
+
+/**
+ * @brief Joins the supervisor once the game has exited, call once per frame (main thread).
+ */
+void editor_game_poll();
+
+void editor_game_lock();
+void editor_game_unlock();
+
+#endif // EDITOR_GAME_H
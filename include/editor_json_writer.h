@@ -0,0 +1,89 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_JSON_WRITER_H
+#define EDITOR_JSON_WRITER_H
+
+/*
+    Streaming JSON writer.
+
+    Emits JSON as it is produced instead of building a jansson tree first,
+    laid out exactly like json_dump_file(..., JSON_INDENT(4)) so files written
+    either way diff cleanly. Output collects in a buffer, which is flushed
+    into an SDL_IOStream whenever it fills up (or kept whole when there is
+    no stream, e.g. to cache a fragment).
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <jansson.h>
+#include <yoyoengine/yoyoengine.h>
+
+#define EDITOR_JSON_WRITER_MAX_DEPTH 32
+#define EDITOR_JSON_WRITER_BUFFER (64 * 1024)
+
+struct editor_json_writer {
+    char *buf;
+    size_t len;
+    size_t cap;
+    SDL_IOStream *io;       // NULL keeps the whole output in buf
+    bool failed;            // out of memory, a write error or nesting too deep
+
+    int base_depth;         // indentation of the first value, for fragments nested in a document
+    int depth;
+    bool has_items[EDITOR_JSON_WRITER_MAX_DEPTH];
+    bool after_key;         // the next value goes on the line of its key
+};
+
+/**
+ * @brief Prepares a writer.
+ *
+ * @param io Stream to flush into, NULL to keep the output in memory
+ * @param base_depth Indentation level the output will sit at, 0 for a whole document
+ */
+void editor_json_writer_init(struct editor_json_writer *writer, SDL_IOStream *io, int base_depth);
+
+/**
+ * @brief Flushes what is left into the stream and frees the buffer.
+ *
+ * @return false if anything failed along the way
+ */
+bool editor_json_writer_finish(struct editor_json_writer *writer);
+
+/**
+ * @brief Hands over the in memory output (NUL terminated, free() it), the writer is reset.
+ *
+ * @return NULL if writing failed
+ */
+char * editor_json_writer_take(struct editor_json_writer *writer, size_t *len);
+
+void editor_json_writer_begin_object(struct editor_json_writer *writer);
+void editor_json_writer_end_object(struct editor_json_writer *writer);
+void editor_json_writer_begin_array(struct editor_json_writer *writer);
+void editor_json_writer_end_array(struct editor_json_writer *writer);
+
+// object keys, the next call writes their value
+void editor_json_writer_key(struct editor_json_writer *writer, const char *key);
+
+void editor_json_writer_string(struct editor_json_writer *writer, const char *value);
+void editor_json_writer_integer(struct editor_json_writer *writer, long long value);
+void editor_json_writer_real(struct editor_json_writer *writer, double value);
+void editor_json_writer_boolean(struct editor_json_writer *writer, bool value);
+void editor_json_writer_null(struct editor_json_writer *writer);
+
+/**
+ * @brief Writes a value that was already written by another writer at this depth.
+ */
+void editor_json_writer_fragment(struct editor_json_writer *writer, const char *text, size_t len);
+
+/**
+ * @brief Writes any jansson value.
+ */
+void editor_json_writer_value(struct editor_json_writer *writer, json_t *value);
+
+#endif // EDITOR_JSON_WRITER_H
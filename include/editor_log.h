@@ -0,0 +1,91 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_LOG_H
+#define EDITOR_LOG_H
+
+/*
+    Bounded, thread safe ring buffer of text lines.
+
+    Used to capture the output of child processes (cmake, the compiler, ...)
+    from a worker thread while the UI reads it every frame. Once full, the
+    oldest lines are overwritten.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#define EDITOR_LOG_LINE_MAX 512
+
+enum editor_log_kind {
+    EDITOR_LOG_NORMAL,
+    EDITOR_LOG_WARNING,
+    EDITOR_LOG_ERROR
+};
+
+struct editor_log_line {
+    enum editor_log_kind kind;
+    char text[EDITOR_LOG_LINE_MAX];
+};
+
+/*
+    Called for every completed line fed through editor_log_ring_write(),
+    returns the kind the line should be stored as
+*/
+typedef enum editor_log_kind (*editor_log_line_cb)(const char *line, void *userdata);
+
+struct editor_log_ring {
+    SDL_Mutex *mutex;
+
+    struct editor_log_line *lines;
+    int capacity;
+    int head;   // index of the oldest line
+    int count;
+
+    // bytes of a line that has not seen its newline yet
+    char partial[EDITOR_LOG_LINE_MAX];
+    size_t partial_len;
+};
+
+void editor_log_ring_init(struct editor_log_ring *ring, int capacity);
+
+void editor_log_ring_destroy(struct editor_log_ring *ring);
+
+void editor_log_ring_clear(struct editor_log_ring *ring);
+
+/**
+ * @brief Appends a single complete line to the ring
+ */
+void editor_log_ring_push(struct editor_log_ring *ring, const char *line, enum editor_log_kind kind);
+
+/**
+ * @brief Feeds raw bytes (as read from a pipe) into the ring, splitting them into lines.
+ *
+ * @param cb Optional, invoked for each completed line before it is stored
+ */
+void editor_log_ring_write(struct editor_log_ring *ring, const char *data, size_t len, editor_log_line_cb cb, void *userdata);
+
+/**
+ * @brief Stores whatever is left in the partial line buffer (call once the stream hits EOF)
+ */
+void editor_log_ring_flush(struct editor_log_ring *ring, editor_log_line_cb cb, void *userdata);
+
+/*
+    Readers must hold the lock while using editor_log_ring_line(),
+    the returned pointer is only valid until the lock is released
+*/
+void editor_log_ring_lock(struct editor_log_ring *ring);
+void editor_log_ring_unlock(struct editor_log_ring *ring);
+
+/**
+ * @brief Returns the i'th oldest line in the ring (0 <= i < ring->count)
+ */
+const struct editor_log_line * editor_log_ring_line(struct editor_log_ring *ring, int i);
+
+#endif // EDITOR_LOG_H
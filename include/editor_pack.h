@@ -0,0 +1,123 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_PACK_H
+#define EDITOR_PACK_H
+
+/*
+    Background packing of the project's .yep files.
+
+    Each pack is tracked by a manifest of its inputs, so unchanged
+    directories are never repacked (unless forced).
+
+    engine_resources only change with the engine, so engine.yep is packed
+    once per engine version into an editor wide cache and every project
+    links (or copies) that pack instead of packing its own.
+
+    engine.yep and resources.yep are independent, so each gets its own
+    worker thread and they pack at the same time. The main thread starts
+    the jobs and reaps them in editor_pack_poll(), other threads (the build
+    thread) may only wait on them through editor_pack_await().
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_log.h"
+
+enum editor_pack_state {
+    EDITOR_PACK_IDLE,
+    EDITOR_PACK_RUNNING,
+    EDITOR_PACK_DONE
+};
+
+// everything a pack is started with
+struct editor_pack_request {
+    char name[64];
+    char source[1024];
+    char output[1024];
+    char manifest[1024];
+    char cache_dir[1024];
+    bool force;
+    struct editor_log_ring *log;
+};
+
+struct editor_pack_job {
+    char name[64];          // output file name, for display
+    char source[1024];
+    char output[1024];
+    char manifest[1024];    // content manifest from the last pack, see editor_pack.c
+    bool force;
+    char cache_dir[1024];   // editor wide cache of packs keyed by manifest digest, "" for none
+    struct editor_log_ring *log; // where the result line goes
+
+    // results, valid once the job is done
+    bool skipped;           // nothing changed since the last pack
+    bool from_cache;        // linked/copied from cache_dir instead of packed
+    int files_total;
+    int files_hashed;       // files whose content had to be read this time
+
+    SDL_Thread *thread;
+    SDL_AtomicInt state;    // enum editor_pack_state
+
+    // a request that came in while running, the worker runs it before reporting done
+    SDL_SpinLock pending_lock;
+    bool has_pending;
+    struct editor_pack_request pending;
+
+    Uint64 start_ticks;
+    Uint64 end_ticks;       // written by the worker before it flips state to done
+};
+
+#define EDITOR_PACK_NUM_JOBS 2
+
+// bump when the manifest layout changes, old manifests are then ignored
+#define EDITOR_PACK_MANIFEST_VERSION 1
+
+extern struct editor_pack_job editor_pack_jobs[EDITOR_PACK_NUM_JOBS];
+
+/**
+ * @brief Starts packing engine.yep and resources.yep in the background.
+ * If packs are already running, the request is folded into them, or
+ * queued behind them if it asks for more (e.g. a forced repack).
+ *
+ * Must be called from the main thread.
+ */
+void editor_pack_start(bool force);
+
+/**
+ * @brief Packs engine.yep and resources.yep of a project that is not the open one
+ * into caller owned jobs (EDITOR_PACK_NUM_JOBS of them). Must be called from the main thread.
+ */
+void editor_pack_start_project(struct editor_pack_job *jobs, const char *project_root, bool force, struct editor_log_ring *log);
+
+/**
+ * @brief Joins whichever of the caller owned jobs have finished (main thread).
+ *
+ * @return true once none of them is running
+ */
+bool editor_pack_jobs_poll(struct editor_pack_job *jobs);
+
+/**
+ * @brief Joins any pack jobs that have finished, call once per frame (main thread).
+ */
+void editor_pack_poll();
+
+/**
+ * @brief Blocks the main thread until all running pack jobs are done.
+ */
+void editor_pack_wait();
+
+/**
+ * @brief Waits for all running pack jobs without joining them, safe to call from worker threads.
+ */
+void editor_pack_await();
+
+bool editor_pack_is_running();
+
+#endif // EDITOR_PACK_H
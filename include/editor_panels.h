@@ -29,6 +29,26 @@ void editor_panel_loading(struct nk_context *ctx);
 void editor_panel_scene_settings(struct nk_context *ctx);
 void editor_panel_scene_settings_reset();
 
+void editor_panel_build_notify(bool success, const char *message);
+void editor_panel_build_notification(struct nk_context *ctx);
+void editor_panel_build_log_open();
+void editor_panel_build_log(struct nk_context *ctx);
+void editor_panel_build_matrix(struct nk_context *ctx);
+
+void editor_panel_game_open();
+void editor_panel_game(struct nk_context *ctx);
+
+void editor_panel_profile_open();
+void editor_panel_profile(struct nk_context *ctx);
+
+void editor_panel_size_report(struct nk_context *ctx);
+
+void editor_panel_batch_open();
+void editor_panel_batch(struct nk_context *ctx);
+
+void editor_panel_scene_binary_open();
+void editor_panel_scene_binary(struct nk_context *ctx);
+
 void editor_init_panel_welcome();
 void editor_panel_welcome(struct nk_context *ctx);
 
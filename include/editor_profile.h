@@ -0,0 +1,110 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_PROFILE_H
+#define EDITOR_PROFILE_H
+
+/*
+    gprof profiles of profiling builds (build.yoyo "profiling").
+
+    Games launched from a profiling build write gmon.out.<pid> into their
+    build tree when they quit. Once the game has exited the editor runs
+    gprof over it in the background and parses the flat profile and the
+    call graph for the profile panel.
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#define EDITOR_PROFILE_NAME_MAX 256
+
+// one row of the flat profile
+struct editor_profile_function {
+    char name[EDITOR_PROFILE_NAME_MAX];
+    int index;              // [N] in the call graph, -1 if it is not in it
+    float percent;          // share of the sampled time spent in the function itself
+    float self_seconds;
+    float total_seconds;    // self + children, from the call graph
+    long calls;             // -1 if the function was not compiled with -pg
+    float self_ms_per_call;
+    float total_ms_per_call;
+};
+
+// a caller or callee line of one call graph entry
+struct editor_profile_arc {
+    int owner;              // call graph index of the entry the line belongs to
+    bool is_caller;
+    char name[EDITOR_PROFILE_NAME_MAX];
+    float self_seconds;
+    float child_seconds;
+    char calls[32];         // as printed, e.g. "3/10"
+};
+
+enum editor_profile_sort_key {
+    EDITOR_PROFILE_SORT_SELF,
+    EDITOR_PROFILE_SORT_TOTAL,
+    EDITOR_PROFILE_SORT_CALLS,
+    EDITOR_PROFILE_SORT_SELF_PER_CALL,
+    EDITOR_PROFILE_SORT_TOTAL_PER_CALL,
+    EDITOR_PROFILE_SORT_NAME
+};
+
+/*
+    Everything below is guarded by editor_profile_lock()/editor_profile_unlock()
+*/
+struct editor_profile_state {
+    int status;             // 0 = nothing loaded, 1 = analyzing, 2 = ready, 3 = error
+    char status_msg[256];
+    char source[1024];      // the gmon.out the profile was read from
+    float sampled_seconds;
+
+    struct editor_profile_function *functions;
+    int num_functions;
+    struct editor_profile_arc *arcs;
+    int num_arcs;
+
+    enum editor_profile_sort_key sort_key;
+};
+
+extern struct editor_profile_state editor_profile;
+
+void editor_profile_init();
+
+void editor_profile_shutdown();
+
+/**
+ * @brief Where games of the active build configuration write their profile
+ * (GMON_OUT_PREFIX, glibc appends .<pid>).
+ */
+bool editor_profile_output_prefix(char *out, size_t size);
+
+/**
+ * @brief Remembers a game launched from a profiling build, its profile is
+ * analyzed once it exits. Call from the main thread.
+ */
+void editor_profile_expect(const char *exe_path, Sint64 pid);
+
+/**
+ * @brief Runs gprof over a profile in the background, replacing the loaded one.
+ */
+bool editor_profile_load(const char *exe_path, const char *gmon_path);
+
+/**
+ * @brief Picks up exited profiled games and finished analyses, call once per frame (main thread).
+ */
+void editor_profile_poll();
+
+/**
+ * @brief Sorts the flat profile, names ascending and everything else descending.
+ */
+void editor_profile_sort(enum editor_profile_sort_key key);
+
+void editor_profile_lock();
+void editor_profile_unlock();
+
+#endif // EDITOR_PROFILE_H
@@ -0,0 +1,108 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_SCENE_BINARY_H
+#define EDITOR_SCENE_BINARY_H
+
+/*
+    Compact binary encoding of scene files (.yoyob).
+
+    Any JSON document round trips losslessly: decoding gives back a jansson
+    tree equal to the one encoded, with the same key order, so dumping it
+    with JSON_INDENT(4) reproduces the .yoyo file byte for byte.
+
+    Layout (little endian, "varint" is unsigned LEB128):
+
+        header   "YOYB", u16 version, u16 flags (0),
+                 u32 string count, u32 shape count
+        strings  per string: varint length, bytes        (keys and string values, each stored once)
+        shapes   per shape: varint key count, varint string index per key
+        root     one value
+
+    Values are a tag byte followed by their payload:
+
+        NULL, FALSE, TRUE       nothing
+        INT                     zigzag varint
+        F32 / F64               4 / 8 bytes, a real is stored as F32 whenever that is exact
+        STRING                  varint string index
+        ARRAY                   varint count, values
+        OBJECT                  varint shape index, one value per key of the shape
+
+    Objects with the same keys in the same order (every transform, every
+    renderer of a type, every tile position...) share one shape, so a scene
+    made of thousands of similar entities spells each key out once.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <jansson.h>
+#include <yoyoengine/yoyoengine.h>
+
+#define EDITOR_SCENE_BINARY_MAGIC "YOYB"
+#define EDITOR_SCENE_BINARY_VERSION 1
+#define EDITOR_SCENE_BINARY_EXTENSION ".yoyob"
+
+// nesting deeper than this is refused when decoding (scenes stay well below)
+#define EDITOR_SCENE_BINARY_MAX_DEPTH 64
+
+/*
+    None of these log, they also run on the scene save thread. Functions
+    that can fail take an error buffer (NULL to ignore) describing why.
+*/
+
+/**
+ * @brief Encodes a JSON document.
+ *
+ * @return malloc'd buffer (free() it), NULL on failure
+ */
+Uint8 * editor_scene_binary_encode(json_t *root, size_t *len);
+
+/**
+ * @brief Decodes a buffer written by editor_scene_binary_encode.
+ *
+ * @return new reference, NULL if the data is malformed
+ */
+json_t * editor_scene_binary_decode(const Uint8 *data, size_t len, char *error, size_t error_size);
+
+bool editor_scene_binary_write(const char *path, json_t *root, char *error, size_t error_size);
+
+// new reference, NULL on failure
+json_t * editor_scene_binary_read(const char *path, char *error, size_t error_size);
+
+/*
+    Converters between the two formats, paths are absolute
+*/
+bool editor_scene_binary_from_json(const char *json_path, const char *binary_path, char *error, size_t error_size);
+bool editor_scene_binary_to_json(const char *binary_path, const char *json_path, char *error, size_t error_size);
+
+/**
+ * @brief Fills out with the binary sibling of a .yoyo path (scenes/a.yoyo -> scenes/a.yoyob).
+ */
+void editor_scene_binary_path(const char *json_path, char *out, size_t size);
+
+/*
+    Load/save benchmark of one scene file in both formats, all in memory
+    (disk access is left out, it would mostly measure the OS cache)
+*/
+struct editor_scene_binary_benchmark {
+    int iterations;
+    size_t json_bytes;
+    size_t binary_bytes;
+
+    // best of the iterations, in milliseconds
+    double json_load_ms;
+    double json_save_ms;
+    double binary_load_ms;
+    double binary_save_ms;
+
+    bool lossless;          // the decoded document equals the parsed JSON
+};
+
+bool editor_scene_binary_benchmark(const char *json_path, int iterations, struct editor_scene_binary_benchmark *out, char *error, size_t error_size);
+
+#endif // EDITOR_SCENE_BINARY_H
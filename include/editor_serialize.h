@@ -13,7 +13,38 @@
 
 /*
     Take the currently opened scene and write it to disk at the provided path
+
+    The file is formatted and written on a background thread (to a temp file
+    that replaces the scene once complete), the global saving flag is set
+    until it is done. Saves requested while one is running are folded into a
+    single follow-up save.
+
+    Saves are incremental: the JSON of every entity is cached and only the
+    entities marked dirty since the last save are serialized again. Selected
+    entities are always treated as dirty (the inspector and the viewport only
+    edit the selection), and deselecting an entity marks it dirty.
 */
 void editor_write_scene_to_disk(const char *path);
 
+/**
+ * @brief Marks an entity as changed, its next save re-serializes it. Call this for
+ * edits that do not go through the selection (hierarchy toggles, new entities, ...).
+ */
+void editor_serialize_mark_dirty(struct ye_entity *entity);
+
+/**
+ * @brief Picks up a finished background save, call once per frame (main thread).
+ */
+void editor_serialize_poll();
+
+/**
+ * @brief Blocks until the running save (and any follow-up) has reached the disk.
+ */
+void editor_serialize_wait();
+
+/**
+ * @brief Drops every cached entity and the cached scene file, call when another scene is loaded.
+ */
+void editor_serialize_invalidate();
+
 #endif
\ No newline at end of file
@@ -0,0 +1,81 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#ifndef EDITOR_SIZE_REPORT_H
+#define EDITOR_SIZE_REPORT_H
+
+/*
+    Size breakdown of what a build ships.
+
+    After every successful interactive build the executable is broken down by
+    section (ELF and PE) and by symbol name prefix (ELF symbol tables), and the
+    packs by top level directory and file type (from their manifests, so these
+    are the sizes going into the pack). Each report is kept in the build tree
+    and the next one is diffed against it.
+*/
+
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#define EDITOR_SIZE_REPORT_FILE "size_report.json"
+
+// symbol groups past this many (smallest first) are folded into "(other)"
+#define EDITOR_SIZE_MAX_SYMBOL_GROUPS 32
+
+enum editor_size_kind {
+    EDITOR_SIZE_FILE,       // whole shipped files
+    EDITOR_SIZE_SECTION,    // executable sections
+    EDITOR_SIZE_SYMBOLS,    // executable symbols by name prefix
+    EDITOR_SIZE_DIRECTORY,  // pack contents by top level directory
+    EDITOR_SIZE_TYPE,       // pack contents by file extension
+    EDITOR_SIZE_NUM_KINDS
+};
+
+struct editor_size_entry {
+    enum editor_size_kind kind;
+    char group[32];         // file the entry belongs to ("game", "engine.yep", ...)
+    char name[128];
+    Sint64 bytes;           // 0 if it is gone since the previous build
+    Sint64 previous;        // -1 if the previous build did not have it
+};
+
+/*
+    Guarded by editor_size_report_lock()/editor_size_report_unlock()
+*/
+struct editor_size_report {
+    bool valid;
+    bool has_previous;      // false for the first report of a build tree
+    Sint64 timestamp;
+    char config[64];        // build dir name
+    struct editor_size_entry *entries;
+    int num_entries;        // sorted by kind, then group, then size descending
+};
+
+extern struct editor_size_report editor_size_report;
+
+void editor_size_report_init();
+
+void editor_size_report_shutdown();
+
+/**
+ * @brief Measures the build and its packs, diffs against and replaces the report
+ * stored in build_dir. Safe to call from worker threads (no ye_path()).
+ */
+bool editor_size_report_generate(const char *exe_path, const char *build_dir, const char *project_root);
+
+/**
+ * @brief Looks up the whole file size of group (and its change) in the current report.
+ *
+ * @return false if the report has no such file, expects the lock to be held
+ */
+bool editor_size_report_file(const char *group, Sint64 *bytes, Sint64 *previous);
+
+void editor_size_report_lock();
+void editor_size_report_unlock();
+
+#endif // EDITOR_SIZE_REPORT_H
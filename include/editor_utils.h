@@ -9,6 +9,9 @@
 #define EDITOR_UTILS_H
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include <yoyoengine/yoyoengine.h>
 
 /**
  * @brief Opens a file or URL in the system's default application.
@@ -27,4 +30,45 @@ void editor_open_in_system(const char *url_or_file_path);
  */
 bool editor_update_window_title(const char *format, ...);
 
+// starting value for editor_hash()
+#define EDITOR_HASH_SEED 0xcbf29ce484222325ULL
+
+/**
+ * @brief 64 bit FNV-1a, chainable by feeding the previous result back in as hash.
+ * Not cryptographic, only meant for change detection.
+ */
+Uint64 editor_hash(Uint64 hash, const void *data, size_t len);
+
+/**
+ * @brief Physical memory currently available to new processes, in MiB.
+ *
+ * @return -1 if it cannot be determined on this platform
+ */
+long editor_available_memory_mb();
+
+/**
+ * @brief Copies a directory tree (regular files and directories only).
+ *
+ * @return false if anything could not be copied, dst may then be partially written
+ */
+bool editor_copy_directory(const char *src, const char *dst);
+
+/**
+ * @brief Removes a directory and everything in it, best effort.
+ */
+void editor_remove_directory(const char *path);
+
+/**
+ * @brief Hard links src to dst, copying instead where links are not possible.
+ * dst must not exist yet.
+ */
+bool editor_link_or_copy(const char *src, const char *dst);
+
+/**
+ * @brief Formats a byte count as B/KiB/MiB/GiB.
+ *
+ * @param sign prefix positive values with '+', for deltas
+ */
+void editor_format_bytes(Sint64 bytes, bool sign, char *out, size_t size);
+
 #endif // EDITOR_UTILS_H
\ No newline at end of file
@@ -18,10 +18,16 @@
 #include "editor.h"
 #include "editor_ui.h"
 #include "editor_build.h"
+#include "editor_pack.h"
+#include "editor_game.h"
+#include "editor_profile.h"
+#include "editor_size_report.h"
+#include "editor_batch.h"
 #include "editor_utils.h"
 #include "editor_input.h"
 #include "editor_panels.h"
 #include "editor_selection.h"
+#include "editor_serialize.h"
 #include "editor_settings_ui.h"
 
 // make some editor specific declarations to change engine core behavior
@@ -217,6 +223,9 @@ void editor_pre_handle_input(SDL_Event event){
 void editor_scene_load_cb(const char *scene_name) {
     (void)scene_name;
 
+    // every entity is new, nothing of the last scene's save cache applies
+    editor_serialize_invalidate();
+
     editor_re_attach_ecs();
     editor_ensure_camera_exists();
     editor_ensure_origin_exists();
@@ -242,6 +251,8 @@ void editor_welcome_loop() {
     while(EDITOR_STATE.mode == ESTATE_WELCOME){
         if(quit)
             exit(0);
+
+        editor_batch_poll();
         
         ye_process_frame();
     }
@@ -319,25 +330,13 @@ void editor_editing_loop() {
     // core editing loop
     while(EDITOR_STATE.mode == ESTATE_EDITING && !quit) {
 
-        // if we are building, check if the build thread has finished
-        while(EDITOR_STATE.is_building) {
-            // SDL3 threading: poll build status and message
-            SDL_LockMutex(EDITOR_STATE.build_mutex);
-            int build_status = EDITOR_STATE.build_status;
-            char buf[256];
-            strncpy(buf, EDITOR_STATE.build_status_msg, sizeof(buf));
-            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-
-            if (build_status != 0) { // 0 = running, 1 = done, 2 = error
-                ye_logf(info, "Build thread status: %s\n", buf);
-                EDITOR_STATE.is_building = false;
-                SDL_WaitThread(EDITOR_STATE.building_thread, NULL);
-                if (build_status == 2) {
-                    ye_logf(error, "Build failed. Check the build log for more information.\n");
-                }
-            }
-            yoyo_loading_refresh(buf);
-        }
+        // if we are building in the background, check if the build thread has finished
+        editor_build_poll();
+        editor_pack_poll();
+        editor_game_poll();
+        editor_profile_poll();
+        editor_batch_poll();
+        editor_serialize_poll();
 
         if(editor_draw_drag_rect)
             ye_debug_render_rect(editor_selecting_rect.x, editor_selecting_rect.y, editor_selecting_rect.w, editor_selecting_rect.h, (SDL_Color){255, 0, 0, 255}, 10);
@@ -348,6 +347,7 @@ void editor_editing_loop() {
     }
 
     // if we have left that loop, cleanup the editor editing state
+    editor_serialize_wait();
     editor_deselect_all();
     ye_purge_ecs();
     remove_ui_component("heiarchy");
@@ -356,6 +356,9 @@ void editor_editing_loop() {
     remove_ui_component("project");
     remove_ui_component("editor_menu_bar");
 
+    // a background build may outlive this project, dont launch it into another one
+    EDITOR_STATE.build_should_run = false;
+
     origin = NULL;
     editor_camera = NULL;
     YE_STATE.engine.target_camera = NULL;
@@ -527,6 +530,11 @@ int main(int argc, char **argv) {
 
     // initialize SDL build mutex for cross-platform build thread sync
     EDITOR_STATE.build_mutex = SDL_CreateMutex();
+    editor_build_init();
+    editor_game_init();
+    editor_profile_init();
+    editor_size_report_init();
+    editor_batch_init();
 
     ye_register_event_cb(YE_EVENT_SCENE_LOAD, editor_scene_load_cb, YE_EVENT_FLAG_PERSISTENT);
 
@@ -577,6 +585,11 @@ int main(int argc, char **argv) {
     editor_settings_ui_shutdown();
 
     // destroy SDL build mutex
+    editor_batch_shutdown();
+    editor_build_shutdown();
+    editor_profile_shutdown();
+    editor_size_report_shutdown();
+    editor_game_shutdown();
     SDL_DestroyMutex(EDITOR_STATE.build_mutex);
 
     // exit
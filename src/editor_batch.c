@@ -0,0 +1,284 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_batch.h"
+#include "editor_build.h"
+#include "editor_build_job.h"
+#include "editor_pack.h"
+
+#define EDITOR_BATCH_DEFAULT_PARALLEL 2
+
+struct editor_batch_state editor_batch;
+
+// project paths come from different places, "a//b/" and "a/b" are the same dir
+static bool batch_same_path(const char *a, const char *b){
+    while(*a || *b){
+        if(*a == '/' && *b == '/'){
+            while(*a == '/') a++;
+            while(*b == '/') b++;
+            continue;
+        }
+        if(*a == '/' && a[strspn(a, "/")] == '\0')
+            return *b == '\0';
+        if(*b == '/' && b[strspn(b, "/")] == '\0')
+            return *a == '\0';
+        if(*a != *b)
+            return false;
+        a++;
+        b++;
+    }
+    return true;
+}
+
+static void batch_project_finish(struct editor_batch_project *project, enum editor_batch_status status, const char *message){
+    project->status = status;
+    snprintf(project->message, sizeof(project->message), "%s", message);
+    if(project->start_ticks)
+        project->total_seconds = (SDL_GetTicks() - project->start_ticks) / 1000.0f;
+}
+
+static bool batch_project_start(struct editor_batch_project *project){
+    bool opened = EDITOR_STATE.opened_project_path && batch_same_path(EDITOR_STATE.opened_project_path, project->path);
+
+    // the editor's own packs write the same .yep files, stay queued until they are done
+    if(opened && editor_pack_is_running())
+        return false;
+
+    project->start_ticks = SDL_GetTicks();
+
+    // the interactive build may be using this very tree
+    if(opened && EDITOR_STATE.is_building){
+        batch_project_finish(project, EDITOR_BATCH_FAILED, "The editor is building this project.");
+        return false;
+    }
+
+    project->job = editor_build_prepare_project_job(project->path);
+    if(!project->job){
+        batch_project_finish(project, EDITOR_BATCH_FAILED, "Could not read settings.yoyo or build.yoyo.");
+        return false;
+    }
+
+    // the running projects split the machine and the budget evenly
+    int share = editor_batch.job_budget / editor_batch.max_parallel;
+    if(share < 1)
+        share = 1;
+    project->job->job_share = editor_batch.max_parallel;
+    if(project->job->max_jobs <= 0 || project->job->max_jobs > share)
+        project->job->max_jobs = share;
+
+    // packing does not depend on the compile, let it overlap with cmake
+    project->packs_done = false;
+    editor_pack_start_project(project->packs, project->path, editor_batch.force_pack, project->job->log);
+
+    if(!editor_build_job_start(project->job)){
+        ye_logf(error, "Failed to start the %s build: %s\n", project->name, SDL_GetError());
+        batch_project_finish(project, EDITOR_BATCH_FAILED, "Could not start the build thread.");
+        return true; // its packs still need reaping
+    }
+
+    project->status = EDITOR_BATCH_RUNNING;
+    snprintf(project->message, sizeof(project->message), "Building %s", project->job->label);
+    return true;
+}
+
+// true once the project is through and nothing of it is running anymore
+static bool batch_project_poll(struct editor_batch_project *project){
+    if(!project->packs_done && editor_pack_jobs_poll(project->packs)){
+        project->packs_done = true;
+        for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+            struct editor_pack_job *pack = &project->packs[i];
+            float seconds = (pack->end_ticks - pack->start_ticks) / 1000.0f;
+            if(pack->end_ticks && seconds > project->pack_seconds)
+                project->pack_seconds = seconds;
+        }
+    }
+
+    if(project->status != EDITOR_BATCH_RUNNING)
+        return project->packs_done;
+
+    int status = editor_build_job_status(project->job);
+    if(status == 0 || !project->packs_done)
+        return false;
+
+    struct editor_build_job *job = project->job;
+    if(job->thread){
+        SDL_WaitThread(job->thread, NULL);
+        job->thread = NULL;
+    }
+    project->configure_seconds = job->configure_seconds;
+    project->compile_seconds = job->compile_seconds;
+    project->parallel_jobs = job->parallel_jobs;
+
+    char message[256];
+    if(status == 1){
+        snprintf(message, sizeof(message), "Built %s", job->label);
+        batch_project_finish(project, EDITOR_BATCH_DONE, message);
+        ye_logf(info, "Batch: %s built in %.1fs.\n", project->name, project->total_seconds);
+    }
+    else if(status == 2){
+        batch_project_finish(project, EDITOR_BATCH_FAILED, job->status_msg);
+        ye_logf(error, "Batch: %s failed (%s).\n", project->name, job->status_msg);
+    }
+    else{
+        batch_project_finish(project, EDITOR_BATCH_CANCELLED, "Cancelled.");
+    }
+    return true;
+}
+
+// drops the results of the last batch, nothing of it may be running
+static void batch_clear(){
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        for(int j = 0; j < EDITOR_PACK_NUM_JOBS; j++){
+            if(project->packs[j].thread)
+                SDL_WaitThread(project->packs[j].thread, NULL);
+        }
+        editor_build_job_destroy(project->job);
+    }
+    memset(editor_batch.projects, 0, sizeof(editor_batch.projects));
+    editor_batch.num_projects = 0;
+}
+
+void editor_batch_init(){
+    memset(&editor_batch, 0, sizeof(editor_batch));
+    editor_batch.max_parallel = EDITOR_BATCH_DEFAULT_PARALLEL;
+    editor_batch.job_budget = SDL_GetNumLogicalCPUCores();
+}
+
+void editor_batch_shutdown(){
+    editor_batch_cancel();
+    batch_clear();
+}
+
+bool editor_batch_start(const char **names, const char **paths, int count){
+    if(editor_batch.running){
+        ye_logf(warning, "A batch build is already running.\n");
+        return false;
+    }
+    if(count <= 0)
+        return false;
+    if(count > EDITOR_BATCH_MAX)
+        count = EDITOR_BATCH_MAX;
+
+    batch_clear();
+
+    for(int i = 0; i < count; i++){
+        bool duplicate = false;
+        for(int j = 0; j < editor_batch.num_projects; j++)
+            duplicate = duplicate || batch_same_path(editor_batch.projects[j].path, paths[i]);
+        if(duplicate){
+            ye_logf(warning, "Skipping %s, it is already part of the batch.\n", names[i]);
+            continue;
+        }
+
+        struct editor_batch_project *project = &editor_batch.projects[editor_batch.num_projects++];
+        snprintf(project->name, sizeof(project->name), "%s", names[i]);
+        snprintf(project->path, sizeof(project->path), "%s", paths[i]);
+        project->status = EDITOR_BATCH_QUEUED;
+        snprintf(project->message, sizeof(project->message), "Queued");
+    }
+
+    if(editor_batch.max_parallel < 1)
+        editor_batch.max_parallel = 1;
+    if(editor_batch.job_budget < 1)
+        editor_batch.job_budget = 1;
+
+    editor_batch.running = true;
+    editor_batch.start_ticks = SDL_GetTicks();
+    editor_batch.end_ticks = 0;
+
+    ye_logf(info, "Batch building %d projects, %d at a time with %d compile jobs between them.\n",
+        editor_batch.num_projects, editor_batch.max_parallel, editor_batch.job_budget);
+    return true;
+}
+
+void editor_batch_cancel(){
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        if(project->status == EDITOR_BATCH_QUEUED)
+            batch_project_finish(project, EDITOR_BATCH_CANCELLED, "Cancelled before it started.");
+        else if(project->status == EDITOR_BATCH_RUNNING)
+            editor_build_job_cancel(project->job);
+    }
+}
+
+void editor_batch_cancel_build_dir(const char *build_dir){
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        if(project->status != EDITOR_BATCH_RUNNING || !project->job->thread || !batch_same_path(project->job->build_dir, build_dir))
+            continue;
+
+        ye_logf(warning, "The batch build is building %s, cancelling that job.\n", project->name);
+        editor_build_job_cancel(project->job);
+        SDL_WaitThread(project->job->thread, NULL);
+        project->job->thread = NULL;
+    }
+}
+
+void editor_batch_wait_project_packs(const char *project_root){
+    if(!project_root)
+        return;
+
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        if(project->packs_done || !batch_same_path(project->path, project_root))
+            continue;
+
+        if(!editor_pack_jobs_poll(project->packs))
+            ye_logf(info, "Waiting for the batch packs of %s ...\n", project->name);
+        // packs_done and the timings are picked up by the next editor_batch_poll()
+        while(!editor_pack_jobs_poll(project->packs))
+            SDL_Delay(20);
+    }
+}
+
+void editor_batch_poll(){
+    if(!editor_batch.running)
+        return;
+
+    int active = 0;
+    bool queued = false;
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        if(project->status == EDITOR_BATCH_QUEUED)
+            queued = true;
+        else if(!batch_project_poll(project))
+            active++;
+    }
+
+    // queue order is selection order
+    for(int i = 0; i < editor_batch.num_projects && active < editor_batch.max_parallel; i++){
+        struct editor_batch_project *project = &editor_batch.projects[i];
+        if(project->status == EDITOR_BATCH_QUEUED && batch_project_start(project))
+            active++;
+    }
+
+    if(active > 0 || queued)
+        return;
+
+    editor_batch.running = false;
+    editor_batch.end_ticks = SDL_GetTicks();
+
+    int built = 0;
+    for(int i = 0; i < editor_batch.num_projects; i++){
+        if(editor_batch.projects[i].status == EDITOR_BATCH_DONE)
+            built++;
+    }
+    float seconds = (editor_batch.end_ticks - editor_batch.start_ticks) / 1000.0f;
+    if(built == editor_batch.num_projects)
+        ye_logf(info, "Batch build finished in %.1fs, all %d projects built.\n", seconds, built);
+    else
+        ye_logf(warning, "Batch build finished in %.1fs, %d of %d projects built.\n", seconds, built, editor_batch.num_projects);
+}
@@ -11,47 +11,200 @@
 #include <stdbool.h>
 
 #include "editor.h"
+#include "editor_log.h"
+#include "editor_build.h"
+#include "editor_build_job.h"
+#include "editor_pack.h"
+#include "editor_game.h"
+#include "editor_profile.h"
+#include "editor_batch.h"
+#include "editor_panels.h"
+#include "editor_utils.h"
 
 #include <yoyoengine/yoyoengine.h>
 
+/*
+    Root of the project a job is being prepared for. NULL means the opened
+    project, the batch build points it at other projects for the duration
+    of editor_build_prepare_project_job()
+*/
+static const char *build_project_root = NULL;
+
+static const char * editor_build_project_root() {
+    return build_project_root ? build_project_root : EDITOR_STATE.opened_project_path;
+}
+
+// ye_path() of the project being prepared, same static buffer caveat
+static const char * editor_build_project_path(const char *subpath) {
+    if(!build_project_root)
+        return ye_path(subpath);
+
+    static char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", build_project_root, subpath);
+    return path;
+}
+
 void editor_build_packs(bool force){
-    // engine resources base dir
-    char *_engine_resources = ye_get_engine_resource_static("");
-    char *engine_resources = malloc(strlen(_engine_resources) + 1);
-    strcpy(engine_resources, _engine_resources);
-
-    // resources base dir
-    char *_resources = ye_path("resources/");
-    char *resources = malloc(strlen(_resources) + 1);
-    strcpy(resources, _resources);
-
-    // engine.yep path
-    char *_engine_yep = ye_path("engine.yep");
-    char *engine_yep = malloc(strlen(_engine_yep) + 1);
-    strcpy(engine_yep, _engine_yep);
-
-    // resources.yep path
-    char *_resources_yep = ye_path("resources.yep");
-    char *resources_yep = malloc(strlen(_resources_yep) + 1);
-    strcpy(resources_yep, _resources_yep);
-
-    if(force){
-        yep_force_pack_directory(engine_resources, engine_yep);
-        yep_force_pack_directory(resources, resources_yep);
-    }
-    else{
-        // pack the /engine_resources into a .yep file
-        yep_pack_directory(engine_resources, engine_yep);
+    // both packs run on their own worker, this just blocks until they are done
+    editor_batch_wait_project_packs(EDITOR_STATE.opened_project_path);
+    editor_pack_start(force);
+    editor_pack_wait();
+}
+
+// only release tags are shared between projects, see editor_engine_cache_dir()
+static bool editor_engine_tag_is_release(const char *core_tag) {
+    return core_tag && core_tag[0] == 'v' && SDL_isdigit((unsigned char)core_tag[1]);
+}
+
+// true if an executable called tool is somewhere on PATH
+static bool editor_build_tool_on_path(const char *tool) {
+    const char *path = SDL_getenv("PATH");
+    if(!path)
+        return false;
+
+    #ifdef _WIN32
+        const char separator = ';';
+        const char *suffix = ".exe";
+    #else
+        const char separator = ':';
+        const char *suffix = "";
+    #endif
 
-        // pack the /resources into a .yep file
-        yep_pack_directory(resources, resources_yep);
+    while(*path){
+        const char *end = strchr(path, separator);
+        size_t len = end ? (size_t)(end - path) : strlen(path);
+        if(len > 0){
+            char candidate[1024];
+            snprintf(candidate, sizeof(candidate), "%.*s/%s%s", (int)len, path, tool, suffix);
+            SDL_PathInfo info;
+            if(SDL_GetPathInfo(candidate, &info) && info.type == SDL_PATHTYPE_FILE)
+                return true;
+        }
+        path += len;
+        if(*path)
+            path++;
     }
+    return false;
+}
+
+/*
+    Returns the compiler cache tool for build.yoyo ("ccache" or "sccache"),
+    or NULL when none is used.
+
+    "auto" (also what build.yoyo files without the key get) turns the cache on
+    for builds against the shared engine source: every project on the same
+    engine tag compiles the same engine files, and ccache/sccache is what lets
+    them reuse each other's engine objects instead of compiling them again
+*/
+static const char * editor_build_compiler_cache(json_t *build_file) {
+    const char *tool = json_string_value(json_object_get(build_file, "compiler_cache"));
+    if(tool && (strcmp(tool, "ccache") == 0 || strcmp(tool, "sccache") == 0))
+        return tool;
+    if(tool && strcmp(tool, "auto") != 0)
+        return NULL;
+
+    const char *core_tag = json_string_value(json_object_get(build_file, "core_tag"));
+    if(json_boolean_value(json_object_get(build_file, "use_local_engine")) || !editor_engine_tag_is_release(core_tag))
+        return NULL;
+
+    if(editor_build_tool_on_path("ccache"))
+        return "ccache";
+    if(editor_build_tool_on_path("sccache"))
+        return "sccache";
+    return NULL;
+}
+
+/*
+    True if build.yoyo asks for a gprof profiling build (-pg). The profile is
+    written when the game the editor launched quits, so like PGO this only
+    applies to the interactive build for this machine, and only where gcc
+    and glibc write gmon.out
+*/
+static bool editor_build_profiling(json_t *build_file, const struct editor_build_config *config) {
+    #ifdef __linux__
+        const char *platform = json_string_value(json_object_get(build_file, "platform"));
+        return !config && platform && strcmp(platform, "linux") == 0 && json_boolean_value(json_object_get(build_file, "profiling"));
+    #else
+        (void)build_file;
+        (void)config;
+        return false;
+    #endif
+}
+
+bool editor_build_profiling_enabled() {
+    json_t *build_file = json_load_file(ye_path("build.yoyo"), 0, NULL);
+    if(!build_file)
+        return false;
+    bool profiling = editor_build_profiling(build_file, NULL);
+    json_decref(build_file);
+    return profiling;
+}
+
+/*
+    True if the host C compiler cmake will pick ($CC, else cc) is GCC. The
+    PGO flags (see editor_build_job.c) are GCC's, clang would look for a
+    .profdata that is never written and fail the optimized rebuild. Windows
+    builds default to MSVC, so PGO stays off there. Probed once, main thread
+*/
+static bool editor_build_compiler_is_gcc() {
+    #ifdef _WIN32
+        return false;
+    #else
+        static int is_gcc = -1;
+        if(is_gcc != -1)
+            return is_gcc == 1;
+        is_gcc = 0;
+
+        const char *compiler = SDL_getenv("CC");
+        if(!compiler || !compiler[0])
+            compiler = "cc";
 
-    // free the memory
-    free(engine_resources);
-    free(resources);
-    free(engine_yep);
-    free(resources_yep);
+        const char *argv[] = {compiler, "--version", NULL};
+        SDL_Process *proc = SDL_CreateProcess(argv, true);
+        char *output = proc ? SDL_ReadProcess(proc, NULL, NULL) : NULL;
+        if(proc)
+            SDL_DestroyProcess(proc);
+
+        if(output && strstr(output, "Free Software Foundation") && !strstr(output, "clang"))
+            is_gcc = 1;
+        else
+            ye_logf(warning, "PGO needs GCC and %s is not GCC, release builds asking for PGO get LTO only.\n", compiler);
+        SDL_free(output);
+        return is_gcc == 1;
+    #endif
+}
+
+/*
+    Returns the optimization build.yoyo asks for ("lto" or "pgo"), or NULL for
+    none. Only release builds are optimized. PGO needs to launch the game for
+    its training run and a GCC compiler, so builds the editor cannot run on
+    this machine (other platforms, matrix jobs) or compile with GCC fall back
+    to plain LTO
+*/
+static const char * editor_build_optimization(json_t *build_file, const struct editor_build_config *config) {
+    const char *optimization = json_string_value(json_object_get(build_file, "optimization"));
+    const char *build_mode = json_string_value(json_object_get(build_file, "build_mode"));
+    const char *platform = json_string_value(json_object_get(build_file, "platform"));
+    if(config && config->build_mode[0])
+        build_mode = config->build_mode;
+    if(config && config->platform[0])
+        platform = config->platform;
+
+    if(!optimization || !build_mode || SDL_strcasecmp(build_mode, "Release") != 0)
+        return NULL;
+
+    #ifdef _WIN32
+        const char *host = "windows";
+    #else
+        const char *host = "linux";
+    #endif
+
+    // an instrumented profiling build cannot train PGO either
+    if(strcmp(optimization, "pgo") == 0)
+        return (!config && platform && strcmp(platform, host) == 0 && !editor_build_profiling(build_file, config) && editor_build_compiler_is_gcc()) ? "pgo" : "lto";
+    if(strcmp(optimization, "lto") == 0)
+        return "lto";
+    return NULL;
 }
 
 // -u is for unbuffered output btw
@@ -61,11 +214,19 @@ void editor_build_packs(bool force){
 // -DCMAKE_C_FLAGS
 // -DYOYO_ENGINE_SOURCE_DIR
 // -DCMAKE_BUILD_TYPE           - "Debug" | "Release"
-// -DGAME_BUILD_DESTINATION     - NOT IMPLEMENTED
+// -DCMAKE_EXE_LINKER_FLAGS     - "-pg" for profiling builds, from build.yoyo "profiling" (-pg is added to the cflags too)
 // -DCMAKE_TOOLCHAIN_FILE
-char **retrieve_build_args() {
-    int num_args = 8;
-    char **args = malloc((num_args + 1) * sizeof(char *));
+// -DCMAKE_C_COMPILER_LAUNCHER   - "ccache" | "sccache", from build.yoyo "compiler_cache" ("auto" picks one for shared engine builds)
+// -DCMAKE_CXX_COMPILER_LAUNCHER
+// -DCMAKE_INTERPROCEDURAL_OPTIMIZATION - LTO, from build.yoyo "optimization"
+// -DYOYO_EDITOR_UNITY_BUILD    - from build.yoyo "unity_build"
+// -DYOYO_EDITOR_PCH            - from build.yoyo "precompiled_header"
+// -DCMAKE_PROJECT_INCLUDE      - editor_resources/cmake/editor_project_include.cmake, applies the two above
+//
+// config overrides the platform/build mode from build.yoyo, NULL uses build.yoyo as is
+char **retrieve_build_args(const struct editor_build_config *config) {
+    int num_args = 14;
+    char **args = calloc(num_args + 1, sizeof(char *));
     if (args == NULL) {
         perror("Failed to allocate memory for args");
         return NULL;
@@ -75,18 +236,23 @@ char **retrieve_build_args() {
     json_t *SETTINGS_FILE = NULL;
     json_t *BUILD_FILE = NULL;
 
-    SETTINGS_FILE = json_load_file(ye_path("settings.yoyo"), 0, NULL);
+    SETTINGS_FILE = json_load_file(editor_build_project_path("settings.yoyo"), 0, NULL);
     if (SETTINGS_FILE == NULL) {
         ye_logf(error, "Failed to read settings file.\n");
         goto error;
     }
 
-    BUILD_FILE = json_load_file(ye_path("build.yoyo"), 0, NULL);
+    BUILD_FILE = json_load_file(editor_build_project_path("build.yoyo"), 0, NULL);
     if (BUILD_FILE == NULL) {
         ye_logf(error, "Failed to read build file.\n");
         goto error;
     }
 
+    if(config && config->platform[0])
+        json_object_set_new(BUILD_FILE, "platform", json_string(config->platform));
+    if(config && config->build_mode[0])
+        json_object_set_new(BUILD_FILE, "build_mode", json_string(config->build_mode));
+
     const char *game_name = json_string_value(json_object_get(SETTINGS_FILE, "name"));
     const char *game_rc_path = json_string_value(json_object_get(BUILD_FILE, "rc_path"));
     const char *cflags = json_string_value(json_object_get(BUILD_FILE, "cflags"));
@@ -95,6 +261,7 @@ char **retrieve_build_args() {
     bool use_local_engine = json_boolean_value(json_object_get(BUILD_FILE, "use_local_engine"));
     const char *local_engine_path = json_string_value(json_object_get(BUILD_FILE, "local_engine_path"));
     const char *build_mode = json_string_value(json_object_get(BUILD_FILE, "build_mode"));
+    bool profiling = editor_build_profiling(BUILD_FILE, config);
 
     if (!game_name || !game_rc_path || !cflags || !platform || !core_tag || !local_engine_path || !build_mode) {
         ye_logf(error, "Failed to get required values from JSON files.\n");
@@ -118,7 +285,7 @@ char **retrieve_build_args() {
     else {
         args[1] = malloc(strlen(game_rc_path) + strlen("-DGAME_RC_PATH=") + 1);
     }
-    args[2] = malloc(strlen(cflags) + strlen("-DCMAKE_C_FLAGS=") + 1);
+    args[2] = malloc(strlen(cflags) + strlen("-DCMAKE_C_FLAGS=") + strlen(" -pg") + 1);
     
     /*
         args[3] is either the engine source dir if we
@@ -126,19 +293,20 @@ char **retrieve_build_args() {
         with fetchcontent
     */
     if(use_local_engine) {
-        args[3] = malloc(strlen(local_engine_path) + strlen("-DYOYO_ENGINE_SOURCE_DIR=\"\"") + 1);
+        args[3] = malloc(strlen(local_engine_path) + strlen("-DYOYO_ENGINE_SOURCE_DIR=") + 1);
     }
     else {
-        args[3] = malloc(strlen(core_tag) + strlen("-DYOYO_ENGINE_BUILD_TAG=\"\"") + 1); // the engine tag for the game to build against. TODO: expose this?
+        args[3] = malloc(strlen(core_tag) + strlen("-DYOYO_ENGINE_BUILD_TAG=") + 1); // the engine tag for the game to build against. TODO: expose this?
     }
     
     // CMake build mode use string from json
     args[4] = malloc(strlen(build_mode) + strlen("-DCMAKE_BUILD_TYPE=") + 1);
     snprintf(args[4], strlen(build_mode) + strlen("-DCMAKE_BUILD_TYPE=") + 1, "-DCMAKE_BUILD_TYPE=%s", build_mode);
     
-    args[5] = malloc(1); // Placeholder for future use
+    args[5] = strdup(profiling ? "-DCMAKE_EXE_LINKER_FLAGS=-pg" : "");
 
-    args[6] = malloc(strlen(EDITOR_STATE.opened_project_path) + strlen("toolchains/") + strlen("-DCMAKE_TOOLCHAIN_FILE=") + 256);
+    const char *project_root = editor_build_project_root();
+    args[6] = malloc(strlen(project_root) + strlen("toolchains/") + strlen("-DCMAKE_TOOLCHAIN_FILE=") + 256);
 
     if (!args[0] || !args[1] || !args[2] || !args[3] || !args[4] || !args[5] || !args[6]) {
         perror("Failed to allocate memory for argument strings");
@@ -154,24 +322,64 @@ char **retrieve_build_args() {
     else {
         snprintf(args[1], strlen(game_rc_path) + strlen("-DGAME_RC_PATH=") + 1, "-DGAME_RC_PATH=%s", game_rc_path);
     }
-    snprintf(args[2], strlen(cflags) + strlen("-DCMAKE_C_FLAGS=") + 1, "-DCMAKE_C_FLAGS=%s", cflags);
+    snprintf(args[2], strlen(cflags) + strlen("-DCMAKE_C_FLAGS=") + strlen(" -pg") + 1, "-DCMAKE_C_FLAGS=%s%s", cflags, profiling ? " -pg" : "");
     if(use_local_engine) {
-        snprintf(args[3], strlen(local_engine_path) + strlen("-DYOYO_ENGINE_SOURCE_DIR=\"\"") + 1, "-DYOYO_ENGINE_SOURCE_DIR=\"%s\"", local_engine_path);
+        snprintf(args[3], strlen(local_engine_path) + strlen("-DYOYO_ENGINE_SOURCE_DIR=") + 1, "-DYOYO_ENGINE_SOURCE_DIR=%s", local_engine_path);
     }
     else {
-        snprintf(args[3], strlen(core_tag) + strlen("-DYOYO_ENGINE_BUILD_TAG=\"\"") + 1, "-DYOYO_ENGINE_BUILD_TAG=\"%s\"", core_tag);
+        snprintf(args[3], strlen(core_tag) + strlen("-DYOYO_ENGINE_BUILD_TAG=") + 1, "-DYOYO_ENGINE_BUILD_TAG=%s", core_tag);
     }
-    args[5][0] = '\0';
 
     if (strcmp(platform, "windows") != 0 && strcmp(platform, "emscripten") != 0) {
         args[6][0] = '\0';
     } else {
-        snprintf(args[6], strlen(EDITOR_STATE.opened_project_path) + strlen("toolchains/") + strlen("-DCMAKE_TOOLCHAIN_FILE=") + 256, "-DCMAKE_TOOLCHAIN_FILE=%s/toolchains/%s.cmake", EDITOR_STATE.opened_project_path, platform);
+        snprintf(args[6], strlen(project_root) + strlen("toolchains/") + strlen("-DCMAKE_TOOLCHAIN_FILE=") + 256, "-DCMAKE_TOOLCHAIN_FILE=%s/toolchains/%s.cmake", project_root, platform);
         printf("toolchain file: %s\n", args[6]);
     }
 
-    // delimeter
-    args[num_args - 1] = strdup("..");
+    // compiler cache, optional and absent from older build.yoyo files
+    const char *compiler_cache = editor_build_compiler_cache(BUILD_FILE);
+    if(compiler_cache) {
+        args[7] = malloc(strlen(compiler_cache) + strlen("-DCMAKE_C_COMPILER_LAUNCHER=") + 1);
+        args[8] = malloc(strlen(compiler_cache) + strlen("-DCMAKE_CXX_COMPILER_LAUNCHER=") + 1);
+        if (!args[7] || !args[8]) {
+            perror("Failed to allocate memory for argument strings");
+            goto error;
+        }
+        snprintf(args[7], strlen(compiler_cache) + strlen("-DCMAKE_C_COMPILER_LAUNCHER=") + 1, "-DCMAKE_C_COMPILER_LAUNCHER=%s", compiler_cache);
+        snprintf(args[8], strlen(compiler_cache) + strlen("-DCMAKE_CXX_COMPILER_LAUNCHER=") + 1, "-DCMAKE_CXX_COMPILER_LAUNCHER=%s", compiler_cache);
+    }
+    else {
+        args[7] = strdup("");
+        args[8] = strdup("");
+    }
+
+    // PGO builds are link time optimized too, the profile flags are added per phase by the build job
+    if(editor_build_optimization(BUILD_FILE, config))
+        args[9] = strdup("-DCMAKE_INTERPROCEDURAL_OPTIMIZATION=ON");
+    else
+        args[9] = strdup("");
+
+    // both are applied to the game's targets by the injected project include
+    bool unity_build = json_boolean_value(json_object_get(BUILD_FILE, "unity_build"));
+    bool precompiled_header = json_boolean_value(json_object_get(BUILD_FILE, "precompiled_header"));
+    args[10] = strdup(unity_build ? "-DYOYO_EDITOR_UNITY_BUILD=ON" : "");
+    args[11] = strdup(precompiled_header ? "-DYOYO_EDITOR_PCH=ON" : "");
+    if(unity_build || precompiled_header) {
+        const char *project_include = editor_resources_path("cmake/editor_project_include.cmake");
+        args[12] = malloc(strlen(project_include) + strlen("-DCMAKE_PROJECT_INCLUDE=") + 1);
+        if (!args[12]) {
+            perror("Failed to allocate memory for argument strings");
+            goto error;
+        }
+        snprintf(args[12], strlen(project_include) + strlen("-DCMAKE_PROJECT_INCLUDE=") + 1, "-DCMAKE_PROJECT_INCLUDE=%s", project_include);
+    }
+    else {
+        args[12] = strdup("");
+    }
+
+    // source dir, absolute since each configuration builds in its own nested dir
+    args[num_args - 1] = strdup(project_root);
     args[num_args] = NULL;
 
     json_decref(SETTINGS_FILE);
@@ -189,20 +397,81 @@ error:
     return NULL;
 }
 
-void editor_run() {
-    json_t *settings  = json_load_file(ye_path("settings.yoyo"), 0, NULL);
-    json_t *build_cfg = json_load_file(ye_path("build.yoyo"),    0, NULL);
+/*
+    Every distinct configuration (platform, build mode, engine source/tag,
+    cflags, ...) gets its own build tree under build/, named after the
+    platform and mode plus a hash of the full configure arguments. Switching
+    back and forth between configurations then reuses a warm tree instead of
+    wiping the cmake cache.
+*/
+static bool editor_build_dir_for_args(char **args, const struct editor_build_config *config, char *out, size_t size) {
+    json_t *build_cfg = json_load_file(editor_build_project_path("build.yoyo"), 0, NULL);
+    if(!build_cfg)
+        return false;
+
+    const char *platform = json_string_value(json_object_get(build_cfg, "platform"));
+    const char *build_mode = json_string_value(json_object_get(build_cfg, "build_mode"));
+    if(config && config->platform[0])
+        platform = config->platform;
+    if(config && config->build_mode[0])
+        build_mode = config->build_mode;
+
+    // PGO configures with different flags per phase, it must not share a tree with plain LTO
+    const char *optimization = editor_build_optimization(build_cfg, config);
+    bool pgo = optimization && strcmp(optimization, "pgo") == 0;
+    bool profiling = editor_build_profiling(build_cfg, config);
+
+    char label[128];
+    snprintf(label, sizeof(label), "%s-%s%s%s", platform ? platform : "unknown", build_mode ? build_mode : "unknown", pgo ? "-pgo" : "", profiling ? "-prof" : "");
+    json_decref(build_cfg);
+
+    // keep the directory name tame no matter what ended up in build.yoyo
+    for(char *c = label; *c; c++){
+        *c = SDL_tolower((unsigned char)*c);
+        if(!SDL_isalnum((unsigned char)*c) && *c != '-')
+            *c = '_';
+    }
+
+    Uint64 hash = EDITOR_HASH_SEED;
+    for(int i = 0; args[i] != NULL; i++)
+        hash = editor_hash(hash, args[i], strlen(args[i]) + 1);
+
+    char rel[256];
+    snprintf(rel, sizeof(rel), "build/%s-%08x", label, (unsigned int)(hash & 0xffffffffu));
+    snprintf(out, size, "%s", editor_build_project_path(rel));
+    return true;
+}
+
+static bool editor_build_dir_for_config(const struct editor_build_config *config, char *out, size_t size) {
+    char **args = retrieve_build_args(config);
+    if(args == NULL)
+        return false;
+
+    bool ok = editor_build_dir_for_args(args, config, out, size);
+
+    for(int i = 0; args[i] != NULL; i++)
+        free(args[i]);
+    free(args);
+    return ok;
+}
+
+bool editor_active_build_dir(char *out, size_t size) {
+    return editor_build_dir_for_config(NULL, out, size);
+}
+
+// the executable_path override only applies to the configuration selected in build.yoyo
+static bool editor_resolve_executable_for_config(const struct editor_build_config *config, char *exe_path, size_t size) {
+    json_t *settings  = json_load_file(editor_build_project_path("settings.yoyo"), 0, NULL);
+    json_t *build_cfg = json_load_file(editor_build_project_path("build.yoyo"),    0, NULL);
     if (!settings || !build_cfg) {
-        ye_logf(error, "editor_run: failed to read settings/build.yoyo\n");
+        ye_logf(error, "editor_resolve_executable: failed to read settings/build.yoyo\n");
         if (settings)  json_decref(settings);
         if (build_cfg) json_decref(build_cfg);
-        return;
+        return false;
     }
 
-    char exe_path[512];
-
     const char *exe_override = json_string_value(json_object_get(build_cfg, "executable_path"));
-    if (exe_override && strlen(exe_override) > 0) {
+    if (!config && exe_override && strlen(exe_override) > 0) {
         // absolute path check: drive letter on Windows, leading slash on Linux/Mac
         #ifdef _WIN32
             bool is_abs = (strlen(exe_override) >= 2 && exe_override[1] == ':');
@@ -210,162 +479,744 @@ void editor_run() {
             bool is_abs = (exe_override[0] == '/');
         #endif
         if (is_abs)
-            snprintf(exe_path, sizeof(exe_path), "%s", exe_override);
+            snprintf(exe_path, size, "%s", exe_override);
         else
-            snprintf(exe_path, sizeof(exe_path), "%s", ye_path(exe_override));
+            snprintf(exe_path, size, "%s", editor_build_project_path(exe_override));
     } else {
         const char *game_name  = json_string_value(json_object_get(settings,  "name"));
         const char *build_mode = json_string_value(json_object_get(build_cfg, "build_mode"));
+        if (config && config->build_mode[0])
+            build_mode = config->build_mode;
         if (!game_name || !build_mode) {
-            ye_logf(error, "editor_run: missing name or build_mode in project settings\n");
+            ye_logf(error, "editor_resolve_executable: missing name or build_mode in project settings\n");
             json_decref(settings);
             json_decref(build_cfg);
-            return;
+            return false;
+        }
+
+        char build_dir[1024];
+        if (!editor_build_dir_for_config(config, build_dir, sizeof(build_dir))) {
+            ye_logf(error, "editor_resolve_executable: could not determine the build directory\n");
+            json_decref(settings);
+            json_decref(build_cfg);
+            return false;
         }
 
-        char rel_path[512];
         #ifdef _WIN32
-            snprintf(rel_path, sizeof(rel_path), "build/%s/%s.exe", build_mode, game_name);
+            snprintf(exe_path, size, "%s/%s/%s.exe", build_dir, build_mode, game_name);
         #else
-            snprintf(rel_path, sizeof(rel_path), "build/%s/%s", build_mode, game_name);
+            snprintf(exe_path, size, "%s/%s/%s", build_dir, build_mode, game_name);
         #endif
-
-        // ye_path returns a static buffer — copy before any further ye_path calls
-        snprintf(exe_path, sizeof(exe_path), "%s", ye_path(rel_path));
     }
 
     json_decref(settings);
     json_decref(build_cfg);
 
+    return true;
+}
+
+bool editor_resolve_executable(char *exe_path, size_t size) {
+    return editor_resolve_executable_for_config(NULL, exe_path, size);
+}
+
+SDL_Environment * editor_run_environment() {
+    SDL_Environment *env = SDL_CreateEnvironment(true);
+
+    // profiling builds write gmon.out.<pid> into their build tree instead of the editor's working dir
+    char gmon_prefix[1100];
+    if(editor_build_profiling_enabled() && editor_profile_output_prefix(gmon_prefix, sizeof(gmon_prefix)))
+        SDL_SetEnvironmentVariable(env, "GMON_OUT_PREFIX", gmon_prefix, true);
+
+    return env;
+}
+
+void editor_run() {
+    // launching against a half written pack would crash the game
+    if(editor_pack_is_running()){
+        ye_logf(info, "Waiting for packs to finish before running ...\n");
+        editor_pack_wait();
+    }
+
+    char exe_path[512];
+    if(!editor_resolve_executable(exe_path, sizeof(exe_path)))
+        return;
+
     if (!ye_file_exists(exe_path)) {
         ye_logf(error, "editor_run: executable not found at %s (build first?)\n", exe_path);
         return;
     }
 
     const char *args[] = { exe_path, NULL };
-    SDL_Process *proc = SDL_CreateProcess(args, false);
+    SDL_Environment *env = editor_run_environment();
+
+    // output is piped to the supervisor, which keeps it for the game panel
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ARGS_POINTER, (void *)args);
+    SDL_SetNumberProperty(props, SDL_PROP_PROCESS_CREATE_STDOUT_NUMBER, SDL_PROCESS_STDIO_APP);
+    SDL_SetBooleanProperty(props, SDL_PROP_PROCESS_CREATE_STDERR_TO_STDOUT_BOOLEAN, true);
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ENVIRONMENT_POINTER, env);
+    SDL_Process *proc = SDL_CreateProcessWithProperties(props);
+    SDL_DestroyProperties(props);
+    SDL_DestroyEnvironment(env);
+
     if (!proc) {
         ye_logf(error, "editor_run: failed to launch game: %s\n", SDL_GetError());
+        return;
     }
+
+    Sint64 pid = SDL_GetNumberProperty(SDL_GetProcessProperties(proc), SDL_PROP_PROCESS_PID_NUMBER, 0);
+    editor_game_attach(proc);
+    editor_panel_game_open();
+
+    if(editor_build_profiling_enabled())
+        editor_profile_expect(exe_path, pid);
 }
 
-struct build_thread_args {
-    bool should_run;
-    bool force_configure;
-};
+/*
+    Build timing history
+*/
+struct editor_build_timing editor_build_history[EDITOR_BUILD_HISTORY_MAX];
+int editor_build_history_count = 0;
+
+// project the in-memory history belongs to
+static char build_history_project[1024] = "";
+
+static void editor_build_history_push(const struct editor_build_timing *timing){
+    if(editor_build_history_count == EDITOR_BUILD_HISTORY_MAX){
+        memmove(&editor_build_history[0], &editor_build_history[1], (EDITOR_BUILD_HISTORY_MAX - 1) * sizeof(struct editor_build_timing));
+        editor_build_history_count--;
+    }
+    editor_build_history[editor_build_history_count++] = *timing;
+}
+
+void editor_build_history_load(){
+    if(!EDITOR_STATE.opened_project_path || strcmp(build_history_project, EDITOR_STATE.opened_project_path) == 0)
+        return;
+    snprintf(build_history_project, sizeof(build_history_project), "%s", EDITOR_STATE.opened_project_path);
+    editor_build_history_count = 0;
+
+    json_t *history = json_load_file(ye_path(EDITOR_BUILD_HISTORY_FILE), 0, NULL);
+    if(!history)
+        return;
+
+    size_t index;
+    json_t *entry;
+    json_array_foreach(json_object_get(history, "builds"), index, entry){
+        struct editor_build_timing timing = {0};
+        timing.timestamp = json_integer_value(json_object_get(entry, "timestamp"));
+        const char *config = json_string_value(json_object_get(entry, "config"));
+        snprintf(timing.config, sizeof(timing.config), "%s", config ? config : "");
+        timing.result = (int)json_integer_value(json_object_get(entry, "result"));
+        timing.pack_engine = (float)json_number_value(json_object_get(entry, "pack_engine"));
+        timing.pack_resources = (float)json_number_value(json_object_get(entry, "pack_resources"));
+        timing.configure = (float)json_number_value(json_object_get(entry, "configure"));
+        timing.compile = (float)json_number_value(json_object_get(entry, "compile"));
+        timing.launch = (float)json_number_value(json_object_get(entry, "launch"));
+        timing.total = (float)json_number_value(json_object_get(entry, "total"));
+        timing.unity_build = json_boolean_value(json_object_get(entry, "unity_build"));
+        timing.precompiled_header = json_boolean_value(json_object_get(entry, "precompiled_header"));
+
+        json_t *benchmark = json_object_get(entry, "benchmark");
+        if(json_is_object(benchmark)){
+            const char *scene = json_string_value(json_object_get(benchmark, "scene"));
+            timing.benchmark.valid = true;
+            snprintf(timing.benchmark.scene, sizeof(timing.benchmark.scene), "%s", scene ? scene : "");
+            timing.benchmark.frames = (int)json_integer_value(json_object_get(benchmark, "frames"));
+            timing.benchmark.p50 = (float)json_number_value(json_object_get(benchmark, "p50"));
+            timing.benchmark.p95 = (float)json_number_value(json_object_get(benchmark, "p95"));
+            timing.benchmark.p99 = (float)json_number_value(json_object_get(benchmark, "p99"));
+            timing.benchmark.max = (float)json_number_value(json_object_get(benchmark, "max"));
+        }
+        editor_build_history_push(&timing);
+    }
+    json_decref(history);
+}
+
+static void editor_build_history_save(){
+    json_t *builds = json_array();
+    for(int i = 0; i < editor_build_history_count; i++){
+        struct editor_build_timing *timing = &editor_build_history[i];
+        json_t *entry = json_object();
+        json_object_set_new(entry, "timestamp", json_integer(timing->timestamp));
+        json_object_set_new(entry, "config", json_string(timing->config));
+        json_object_set_new(entry, "result", json_integer(timing->result));
+        json_object_set_new(entry, "pack_engine", json_real(timing->pack_engine));
+        json_object_set_new(entry, "pack_resources", json_real(timing->pack_resources));
+        json_object_set_new(entry, "configure", json_real(timing->configure));
+        json_object_set_new(entry, "compile", json_real(timing->compile));
+        json_object_set_new(entry, "launch", json_real(timing->launch));
+        json_object_set_new(entry, "total", json_real(timing->total));
+        json_object_set_new(entry, "unity_build", json_boolean(timing->unity_build));
+        json_object_set_new(entry, "precompiled_header", json_boolean(timing->precompiled_header));
+        if(timing->benchmark.valid){
+            json_t *benchmark = json_object();
+            json_object_set_new(benchmark, "scene", json_string(timing->benchmark.scene));
+            json_object_set_new(benchmark, "frames", json_integer(timing->benchmark.frames));
+            json_object_set_new(benchmark, "p50", json_real(timing->benchmark.p50));
+            json_object_set_new(benchmark, "p95", json_real(timing->benchmark.p95));
+            json_object_set_new(benchmark, "p99", json_real(timing->benchmark.p99));
+            json_object_set_new(benchmark, "max", json_real(timing->benchmark.max));
+            json_object_set_new(entry, "benchmark", benchmark);
+        }
+        json_array_append_new(builds, entry);
+    }
+
+    json_t *history = json_object();
+    json_object_set_new(history, "builds", builds);
+    ye_mkdir(ye_path("build"));
+    json_dump_file(history, ye_path(EDITOR_BUILD_HISTORY_FILE), JSON_INDENT(4));
+    json_decref(history);
+}
+
+// build dir name without its trailing args hash, e.g. "linux-release"
+static size_t editor_build_config_prefix_len(const char *config){
+    const char *dash = strrchr(config, '-');
+    return dash ? (size_t)(dash - config) : strlen(config);
+}
+
+bool editor_build_compile_delta(float *with, float *without){
+    editor_build_history_load();
+
+    /*
+        Only builds that configured a tree are compared, those compiled
+        everything. Incremental builds say nothing about the toggles
+    */
+    const struct editor_build_timing *latest = NULL;
+    const struct editor_build_timing *other = NULL;
+    for(int i = editor_build_history_count - 1; i >= 0; i--){
+        const struct editor_build_timing *timing = &editor_build_history[i];
+        if(timing->result != 1 || timing->configure <= 0)
+            continue;
+
+        if(!latest){
+            latest = timing;
+            continue;
+        }
+
+        size_t len = editor_build_config_prefix_len(latest->config);
+        bool latest_fast = latest->unity_build || latest->precompiled_header;
+        bool fast = timing->unity_build || timing->precompiled_header;
+        if(fast != latest_fast && editor_build_config_prefix_len(timing->config) == len && strncmp(timing->config, latest->config, len) == 0){
+            other = timing;
+            break;
+        }
+    }
+    if(!latest || !other)
+        return false;
+
+    bool latest_fast = latest->unity_build || latest->precompiled_header;
+    *with = latest_fast ? latest->compile : other->compile;
+    *without = latest_fast ? other->compile : latest->compile;
+    return true;
+}
+
+// seconds a pack job spent on behalf of the build that started at build_start
+static float editor_build_pack_seconds(struct editor_pack_job *job, Uint64 build_start){
+    if(job->end_ticks < job->start_ticks || job->start_ticks + 1000 < build_start)
+        return 0;
+    return (job->end_ticks - job->start_ticks) / 1000.0f;
+}
+
+static void editor_build_history_record(struct editor_build_job *job, int result, float launch_seconds){
+    editor_build_history_load();
 
-static int build_thread_func(void *userdata) {
-    struct build_thread_args *args_struct = (struct build_thread_args *)userdata;
-    bool should_run = args_struct->should_run;
-    bool force_configure = args_struct->force_configure;
-    free(args_struct);
+    struct editor_build_timing timing = {0};
+    SDL_Time now = 0;
+    SDL_GetCurrentTime(&now);
+    timing.timestamp = now / SDL_NS_PER_SECOND;
+    timing.result = result;
 
-    char **args = retrieve_build_args();
+    const char *name = strrchr(job->build_dir, '/');
+    snprintf(timing.config, sizeof(timing.config), "%s", name ? name + 1 : job->build_dir);
+
+    timing.configure = job->configure_seconds;
+    timing.compile = job->compile_seconds;
+    timing.launch = launch_seconds;
+    timing.unity_build = job->unity_build;
+    timing.precompiled_header = job->precompiled_header;
+
+    // only the interactive build packs, matrix builds just compile
+    if(job->interactive){
+        timing.pack_engine = editor_build_pack_seconds(&editor_pack_jobs[0], EDITOR_STATE.build_start_ticks);
+        timing.pack_resources = editor_build_pack_seconds(&editor_pack_jobs[1], EDITOR_STATE.build_start_ticks);
+        timing.total = (SDL_GetTicks() - EDITOR_STATE.build_start_ticks) / 1000.0f;
+    }
+    else{
+        timing.total = (job->end_ticks - job->start_ticks) / 1000.0f;
+    }
+
+    editor_build_history_push(&timing);
+    editor_build_history_save();
+}
+
+/*
+    Build output capture
+*/
+struct editor_log_ring editor_build_log;
+struct editor_build_diagnostic editor_build_diagnostics[EDITOR_BUILD_MAX_DIAGNOSTICS];
+int editor_build_num_diagnostics = 0;
+
+void editor_build_init(){
+    editor_log_ring_init(&editor_build_log, EDITOR_BUILD_LOG_LINES);
+}
+
+/*
+    Engine cache
+
+    Fetched engine sources are shared between all projects through a per user
+    cache, keyed by the engine tag. Only release tags are cached, a branch
+    name moves and its cached copy would go stale.
+*/
+static bool editor_engine_cache_dir(const char *core_tag, char *out, size_t size){
+    out[0] = '\0';
+    if(!editor_engine_tag_is_release(core_tag))
+        return false;
+
+    char *pref = SDL_GetPrefPath("yoyoengine", "yoyoeditor");
+    if(!pref)
+        return false;
+
+    char engine_dir[1024];
+    snprintf(engine_dir, sizeof(engine_dir), "%sengine", pref);
+    SDL_CreateDirectory(engine_dir);
+    snprintf(out, size, "%s/%s", engine_dir, core_tag);
+    SDL_free(pref);
+
+    // the tag ends up in a path
+    for(char *c = out + strlen(engine_dir) + 1; *c; c++){
+        if(!SDL_isalnum((unsigned char)*c) && *c != '.' && *c != '-')
+            *c = '_';
+    }
+    return true;
+}
+
+/*
+    Job setup
+
+    Resolves everything a job needs for one configuration on the main thread,
+    config NULL builds what build.yoyo currently selects
+*/
+static bool editor_build_prepare_job(struct editor_build_job *job, const struct editor_build_config *config, bool force_configure){
+    char **args = retrieve_build_args(config);
     if(args == NULL){
-        SDL_LockMutex(EDITOR_STATE.build_mutex);
-        EDITOR_STATE.build_status = 2;
-        snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "Failed to retrieve build args.");
-        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-        return 1;
+        ye_logf(error, "Failed to retrieve build args.\n");
+        return false;
     }
 
-    json_t *BUILD_FILE = json_load_file(ye_path("build.yoyo"), 0, NULL);
-    if (BUILD_FILE == NULL) {
-        SDL_LockMutex(EDITOR_STATE.build_mutex);
-        EDITOR_STATE.build_status = 2;
-        snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "Failed to read build file.");
-        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-        return 1;
+    if(!editor_build_dir_for_args(args, config, job->build_dir, sizeof(job->build_dir))){
+        ye_logf(error, "Failed to read build file.\n");
+        for(int i = 0; args[i] != NULL; i++)
+            free(args[i]);
+        free(args);
+        return false;
     }
+    ye_mkdir(editor_build_project_path("build"));
+
+    const char *name = strrchr(job->build_dir, '/');
+    snprintf(job->label, sizeof(job->label), "%s", name ? name + 1 : job->build_dir);
 
-    if(force_configure || json_boolean_value(json_object_get(BUILD_FILE, "delete_cache"))) {
-        ye_delete_file(ye_path("build/CMakeCache.txt"));
-        json_object_set_new(BUILD_FILE, "delete_cache", json_false());
+    job->force_configure = force_configure;
+    job->job_share = 1;
+    snprintf(job->cmake_cache_path, sizeof(job->cmake_cache_path), "%s/CMakeCache.txt", job->build_dir);
+    snprintf(job->fingerprint_path, sizeof(job->fingerprint_path), "%s/editor_fingerprint", job->build_dir);
+    snprintf(job->build_file_path, sizeof(job->build_file_path), "%s", editor_build_project_path("build.yoyo"));
+    snprintf(job->project_root, sizeof(job->project_root), "%s", editor_build_project_root());
+    if(!editor_resolve_executable_for_config(config, job->exe_path, sizeof(job->exe_path)))
+        job->exe_path[0] = '\0';
+
+    json_t *build_file = json_load_file(job->build_file_path, 0, NULL);
+    if(build_file){
+        const char *compiler_cache = editor_build_compiler_cache(build_file);
+        const char *compiler_cache_size = json_string_value(json_object_get(build_file, "compiler_cache_max_size"));
+        snprintf(job->compiler_cache, sizeof(job->compiler_cache), "%s", compiler_cache ? compiler_cache : "");
+        snprintf(job->compiler_cache_size, sizeof(job->compiler_cache_size), "%s", compiler_cache_size ? compiler_cache_size : "");
+        job->max_jobs = (int)json_integer_value(json_object_get(build_file, "max_jobs"));
+        job->unity_build = json_boolean_value(json_object_get(build_file, "unity_build"));
+        job->precompiled_header = json_boolean_value(json_object_get(build_file, "precompiled_header"));
+
+        const char *optimization = editor_build_optimization(build_file, config);
+        job->pgo = optimization && strcmp(optimization, "pgo") == 0;
+        job->pgo_seconds = (int)json_integer_value(json_object_get(build_file, "pgo_seconds"));
+        if(job->pgo_seconds <= 0)
+            job->pgo_seconds = 30;
+
+        const char *core_tag = json_string_value(json_object_get(build_file, "core_tag"));
+        if(!json_boolean_value(json_object_get(build_file, "use_local_engine")))
+            editor_engine_cache_dir(core_tag, job->engine_cache_dir, sizeof(job->engine_cache_dir));
+        json_decref(build_file);
     }
 
-    json_dump_file(BUILD_FILE, ye_path("build.yoyo"), JSON_INDENT(4));
-    json_decref(BUILD_FILE);
-    BUILD_FILE = NULL;
+    // an explicit reconfigure starts this configuration over, other configurations are untouched
+    if(force_configure)
+        ye_delete_file(job->cmake_cache_path);
 
-    // create a system argument string
-    char invoke[512];
-    snprintf(invoke, sizeof(invoke), "cmake ");
+    /*
+        The configure command line. Source and build dir are passed explicitly
+        so the job never depends on the working directory. The last arg is the
+        source dir (already covered by -S), empty args are optional ones that
+        were left unset
+    */
+    int num_args = 0;
+    while(args[num_args] != NULL)
+        num_args++;
+
+    job->configure_argv = calloc(num_args + 7, sizeof(char *));
+    int argc = 0;
+    job->configure_argv[argc++] = strdup("cmake");
+    job->configure_argv[argc++] = strdup("-S");
+    job->configure_argv[argc++] = strdup(job->project_root);
+    job->configure_argv[argc++] = strdup("-B");
+    job->configure_argv[argc++] = strdup(job->build_dir);
     for(int i = 0; args[i] != NULL; i++){
-        if(strlen(args[i]) == 0) continue;
-        char *equal_sign = strchr(args[i], '=');
-        if (equal_sign != NULL && strchr(equal_sign + 1, ' ')) {
-            *equal_sign = '\0';
-            strcat(invoke, args[i]);
-            strcat(invoke, "=");
-            strcat(invoke, "\"");
-            strcat(invoke, equal_sign + 1);
-            strcat(invoke, "\" ");
-        } else {
-            strcat(invoke, args[i]);
-            strcat(invoke, " ");
+        if(i == num_args - 1 || strlen(args[i]) == 0){
+            free(args[i]);
+            continue;
         }
+        job->configure_argv[argc++] = args[i]; // ownership moves to the job
     }
 
-    // create build dir (cross-platform)
-    ye_mkdir(ye_path("build"));
-    ye_chdir(ye_path("build"));
-
-    bool cmake_cache_exists = ye_file_exists(ye_path("build/CMakeCache.txt"));
-
-    // CMake step
-    if (force_configure || !cmake_cache_exists) {
-        SDL_LockMutex(EDITOR_STATE.build_mutex);
-        snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "Running CMake ...");
-        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-        if(system(invoke) != 0){
-            SDL_LockMutex(EDITOR_STATE.build_mutex);
-            EDITOR_STATE.build_status = 2;
-            snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "error");
-            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-            return 1;
+    // another project already fetched this engine tag, build against its copy instead of downloading it again
+    if(job->engine_cache_dir[0] && SDL_GetPathInfo(job->engine_cache_dir, NULL)){
+        size_t len = strlen(EDITOR_ENGINE_SOURCE_ARG) + strlen(job->engine_cache_dir) + 1;
+        job->configure_argv[argc] = malloc(len);
+        snprintf(job->configure_argv[argc++], len, "%s%s", EDITOR_ENGINE_SOURCE_ARG, job->engine_cache_dir);
+    }
+    job->configure_argv[argc] = NULL;
+    free(args);
+
+    return true;
+}
+
+struct editor_build_job * editor_build_prepare_project_job(const char *project_root){
+    struct editor_build_job *job = editor_build_job_create(false);
+    if(!job)
+        return NULL;
+
+    /*
+        An empty config builds what the project's build.yoyo selects, but like
+        the matrix it never trains PGO or instruments for gprof: both launch
+        the game, which only makes sense for the opened project
+    */
+    struct editor_build_config config = {0};
+
+    build_project_root = project_root;
+    bool ok = editor_build_prepare_job(job, &config, false);
+    build_project_root = NULL;
+
+    if(!ok){
+        editor_build_job_destroy(job);
+        return NULL;
+    }
+    return job;
+}
+
+/*
+    Build queue
+
+    Only one interactive build ever runs. A request that comes in while
+    building makes the running build stale: it is cancelled and folded,
+    together with the new request, into a single follow-up build that starts
+    once the old one has been reaped in editor_build_poll().
+*/
+static struct editor_build_job *build_active_job = NULL;
+static struct {
+    bool pending;
+    bool force_configure;
+    bool should_run;
+} build_queued;
+
+static void editor_build_cancel_active() {
+    if(build_active_job)
+        editor_build_job_cancel(build_active_job);
+}
+
+void editor_build_cancel(){
+    build_queued.pending = false;
+    if(!EDITOR_STATE.is_building)
+        return;
+
+    ye_logf(info, "Cancelling build ...\n");
+    EDITOR_STATE.build_should_run = false;
+    editor_build_cancel_active();
+}
+
+static void editor_build_start(bool force_configure, bool should_run){
+    struct editor_build_job *job = editor_build_job_create(true);
+    if(!job || !editor_build_prepare_job(job, NULL, force_configure)){
+        editor_build_job_destroy(job);
+        return;
+    }
+
+    // a matrix job writing into the same tree would corrupt both builds
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        struct editor_build_job *other = editor_build_matrix_jobs[i];
+        if(editor_build_job_status(other) == 0 && strcmp(other->build_dir, job->build_dir) == 0){
+            ye_logf(warning, "The build matrix is building %s, cancelling that job.\n", other->label);
+            editor_build_job_cancel(other);
+            SDL_WaitThread(other->thread, NULL);
+            other->thread = NULL;
         }
     }
 
-    // Build step
+    // same for a batch build of this project
+    editor_batch_cancel_build_dir(job->build_dir);
+
+    job->wait_for_packs = should_run;
+
+    EDITOR_STATE.is_building = true;
+    EDITOR_STATE.build_should_run = should_run;
+    EDITOR_STATE.build_start_ticks = SDL_GetTicks();
+
+    editor_log_ring_clear(&editor_build_log);
     SDL_LockMutex(EDITOR_STATE.build_mutex);
-    snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "Building ...");
+    editor_build_num_diagnostics = 0;
+    editor_build_cache_stats.valid = false;
     SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-    if(system("cmake --build . --parallel") != 0){
-        SDL_LockMutex(EDITOR_STATE.build_mutex);
-        EDITOR_STATE.build_status = 2;
-        snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "error");
-        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-        return 1;
+
+    // packing does not depend on the compile, let it overlap with cmake
+    editor_batch_wait_project_packs(EDITOR_STATE.opened_project_path);
+    editor_pack_start(false);
+
+    if(!editor_build_job_start(job)){
+        ye_logf(error, "Failed to create build thread: %s\n", SDL_GetError());
+        EDITOR_STATE.is_building = false;
+        editor_build_job_destroy(job);
+        return;
+    }
+    build_active_job = job;
+    EDITOR_STATE.building_thread = job->thread;
+}
+
+void editor_build(bool force_configure, bool should_run){
+    if(EDITOR_STATE.is_building){
+        // build then build+run collapses into one build+run, nothing is lost by merging
+        build_queued.force_configure = build_queued.force_configure || force_configure || build_active_job->force_configure;
+        build_queued.should_run = build_queued.should_run || should_run || EDITOR_STATE.build_should_run;
+        build_queued.pending = true;
+
+        // the running build is stale now, never launch what it produces
+        EDITOR_STATE.build_should_run = false;
+        editor_build_cancel_active();
+
+        ye_logf(info, "Build requested while building, restarting with the latest changes.\n");
+        return;
+    }
+
+    editor_build_start(force_configure, should_run);
+}
+
+// starts the coalesced follow-up build, if one was requested
+static void editor_build_start_queued(){
+    if(!build_queued.pending)
+        return;
+
+    build_queued.pending = false;
+    editor_build_start(build_queued.force_configure, build_queued.should_run);
+    build_queued.force_configure = false;
+    build_queued.should_run = false;
+}
+
+/*
+    Build matrix
+
+    Builds several configurations side by side, each in its own warm tree.
+    They share one budget of compile jobs so the matrix does not oversubscribe
+    the machine any more than a single build would.
+*/
+struct editor_build_job *editor_build_matrix_jobs[EDITOR_BUILD_MATRIX_MAX];
+int editor_build_matrix_count = 0;
+
+bool editor_build_matrix_running(){
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        if(editor_build_matrix_jobs[i]->thread)
+            return true;
+    }
+    return false;
+}
+
+void editor_build_matrix_cancel(){
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        if(editor_build_matrix_jobs[i]->thread)
+            editor_build_job_cancel(editor_build_matrix_jobs[i]);
+    }
+}
+
+bool editor_build_matrix_start(const struct editor_build_config *configs, int count){
+    if(editor_build_matrix_running()){
+        ye_logf(warning, "The build matrix is already running.\n");
+        return false;
+    }
+    if(count <= 0)
+        return false;
+    if(count > EDITOR_BUILD_MATRIX_MAX)
+        count = EDITOR_BUILD_MATRIX_MAX;
+
+    // results of the previous run are kept around until a new one starts
+    for(int i = 0; i < editor_build_matrix_count; i++)
+        editor_build_job_destroy(editor_build_matrix_jobs[i]);
+    editor_build_matrix_count = 0;
+
+    char active_dir[1024] = "";
+    if(EDITOR_STATE.is_building)
+        snprintf(active_dir, sizeof(active_dir), "%s", build_active_job->build_dir);
+
+    for(int i = 0; i < count; i++){
+        struct editor_build_job *job = editor_build_job_create(false);
+        if(!job)
+            break;
+        if(!editor_build_prepare_job(job, &configs[i], false)){
+            editor_build_job_destroy(job);
+            continue;
+        }
+
+        // the same configuration twice (or the one the editor is building) would share a tree
+        bool duplicate = strcmp(job->build_dir, active_dir) == 0;
+        for(int j = 0; j < editor_build_matrix_count; j++)
+            duplicate = duplicate || strcmp(editor_build_matrix_jobs[j]->build_dir, job->build_dir) == 0;
+        if(duplicate){
+            ye_logf(warning, "Skipping %s, that configuration is already being built.\n", job->label);
+            editor_build_job_destroy(job);
+            continue;
+        }
+
+        editor_build_matrix_jobs[editor_build_matrix_count++] = job;
+    }
+
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        editor_build_matrix_jobs[i]->job_share = editor_build_matrix_count;
+        if(!editor_build_job_start(editor_build_matrix_jobs[i]))
+            ye_logf(error, "Failed to start the %s build: %s\n", editor_build_matrix_jobs[i]->label, SDL_GetError());
+    }
+
+    ye_logf(info, "Building %d configurations side by side.\n", editor_build_matrix_count);
+    return editor_build_matrix_count > 0;
+}
+
+// reaps finished matrix jobs, notifies once the whole matrix is through
+static void editor_build_matrix_poll(){
+    bool reaped = false;
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        struct editor_build_job *job = editor_build_matrix_jobs[i];
+        if(!job->thread)
+            continue;
+
+        int status = editor_build_job_status(job);
+        if(status == 0)
+            continue;
+
+        SDL_WaitThread(job->thread, NULL);
+        job->thread = NULL;
+        reaped = true;
+
+        editor_build_history_record(job, status, 0);
+        if(status == 2)
+            ye_logf(error, "Matrix build %s failed (%s).\n", job->label, job->status_msg);
+        else if(status == 1)
+            ye_logf(info, "Matrix build %s finished in %.1fs.\n", job->label, (job->end_ticks - job->start_ticks) / 1000.0f);
+    }
+
+    if(!reaped || editor_build_matrix_running())
+        return;
+
+    int failed = 0;
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        if(editor_build_job_status(editor_build_matrix_jobs[i]) != 1)
+            failed++;
     }
 
+    char notification[256];
+    if(failed == 0)
+        snprintf(notification, sizeof(notification), "All %d configurations built.", editor_build_matrix_count);
+    else
+        snprintf(notification, sizeof(notification), "%d of %d configurations did not build.", failed, editor_build_matrix_count);
+    editor_panel_build_notify(failed == 0, notification);
+}
+
+void editor_build_poll(){
+    editor_build_matrix_poll();
+
+    if(!EDITOR_STATE.is_building)
+        return;
+
     SDL_LockMutex(EDITOR_STATE.build_mutex);
-    EDITOR_STATE.build_status = 1;
-    snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "done");
+    int build_status = EDITOR_STATE.build_status;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", EDITOR_STATE.build_status_msg);
     SDL_UnlockMutex(EDITOR_STATE.build_mutex);
 
-    // cleanup arg memory
-    for(int i = 0; args[i] != NULL; i++){
-        free(args[i]);
+    if(build_status == 0) // 0 = running, 1 = done, 2 = error, 3 = cancelled
+        return;
+
+    struct editor_build_job *job = build_active_job;
+    SDL_WaitThread(job->thread, NULL);
+    job->thread = NULL;
+    build_active_job = NULL;
+    EDITOR_STATE.building_thread = NULL;
+    EDITOR_STATE.is_building = false;
+
+    float seconds = (SDL_GetTicks() - EDITOR_STATE.build_start_ticks) / 1000.0f;
+    char notification[256];
+
+    if(build_status == 3){
+        editor_build_history_record(job, build_status, 0);
+        editor_build_job_destroy(job);
+        if(build_queued.pending){
+            editor_build_start_queued();
+            return;
+        }
+        ye_logf(info, "Build cancelled after %.1fs.\n", seconds);
+        snprintf(notification, sizeof(notification), "Build cancelled after %.1fs.", seconds);
+        editor_panel_build_notify(false, notification);
+        return;
     }
-    free(args);
 
-    if(should_run){
+    if(build_status == 2){
+        editor_build_history_record(job, build_status, 0);
+        editor_build_job_destroy(job);
+        ye_logf(error, "Build failed (%s). Check the build log for more information.\n", buf);
+        snprintf(notification, sizeof(notification), "Build failed after %.1fs: %s", seconds, buf);
+        editor_panel_build_notify(false, notification);
+
+        // surface the output right away, this is what the user needs to look at next
+        editor_panel_build_log_open();
+        editor_build_start_queued();
+        return;
+    }
+
+    ye_logf(info, "Build finished in %.1fs.\n", seconds);
+    snprintf(notification, sizeof(notification), "Build finished in %.1fs.", seconds);
+    editor_panel_build_notify(true, notification);
+
+    float launch_seconds = 0;
+    if(EDITOR_STATE.build_should_run){
+        Uint64 launch_start = SDL_GetTicks();
         editor_run();
+        launch_seconds = (SDL_GetTicks() - launch_start) / 1000.0f;
     }
-    return 0;
+    editor_build_history_record(job, build_status, launch_seconds);
+    editor_build_job_destroy(job);
+
+    editor_build_start_queued();
 }
 
-void editor_build(bool force_configure, bool should_run){
-    editor_build_packs(false);
-    EDITOR_STATE.is_building = true;
-    EDITOR_STATE.build_status = 0;
-    SDL_LockMutex(EDITOR_STATE.build_mutex);
-    snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "Starting build ...");
-    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
-    struct build_thread_args *args_struct = malloc(sizeof(struct build_thread_args));
-    args_struct->should_run = should_run;
-    args_struct->force_configure = force_configure;
-    EDITOR_STATE.building_thread = SDL_CreateThread(build_thread_func, "BuildThread", args_struct);
+void editor_build_shutdown(){
+    // build threads write into the logs, stop them and let them wind down first
+    editor_build_matrix_cancel();
+    for(int i = 0; i < editor_build_matrix_count; i++){
+        editor_build_job_destroy(editor_build_matrix_jobs[i]);
+        editor_build_matrix_jobs[i] = NULL;
+    }
+    editor_build_matrix_count = 0;
+
+    if(EDITOR_STATE.is_building){
+        editor_build_cancel();
+        editor_build_job_destroy(build_active_job);
+        build_active_job = NULL;
+        EDITOR_STATE.building_thread = NULL;
+        EDITOR_STATE.is_building = false;
+    }
+    editor_pack_wait();
+    editor_log_ring_destroy(&editor_build_log);
 }
 
 void editor_build_and_run(){
@@ -375,5 +1226,3 @@ void editor_build_and_run(){
 void editor_build_reconfigure(){
     editor_build(true, false);
 }
-
-// TODO: make a pretty progess bar
@@ -0,0 +1,1023 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifndef _WIN32
+    #include <signal.h>
+#endif
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_build.h"
+#include "editor_build_job.h"
+#include "editor_size_report.h"
+#include "editor_pack.h"
+#include "editor_utils.h"
+
+static void build_job_set_status(struct editor_build_job *job, int status, float progress, const char *msg) {
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    job->status = status;
+    job->progress = progress;
+    snprintf(job->status_msg, sizeof(job->status_msg), "%s", msg);
+    if(job->interactive){
+        EDITOR_STATE.build_status = status;
+        EDITOR_STATE.build_progress = progress;
+        snprintf(EDITOR_STATE.build_status_msg, sizeof(EDITOR_STATE.build_status_msg), "%s", msg);
+    }
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+}
+
+/*
+    Parses the "[ 45%]" prefix emitted by makefile generators,
+    or the "[12/80]" prefix emitted by ninja
+*/
+static bool build_parse_progress(const char *line, float *out) {
+    while(*line == ' ')
+        line++;
+    if(*line != '[')
+        return false;
+
+    int done, total, percent;
+    if(sscanf(line, "[%d/%d]", &done, &total) == 2 && total > 0){
+        *out = (float)done / (float)total;
+        return true;
+    }
+    if(sscanf(line, "[ %d%%]", &percent) == 1){
+        *out = percent / 100.0f;
+        return true;
+    }
+    return false;
+}
+
+/*
+    Recognizes compiler and cmake diagnostics:
+        path/to/file.c:12:5: error: message      (gcc, clang)
+        path/to/file.c:12: warning: message      (ld, older gcc)
+        path\to\file.c(12): error C2065: message (msvc)
+        CMake Error at CMakeLists.txt:12 (message):
+*/
+static bool build_parse_diagnostic(const char *line, const char *build_dir, struct editor_build_diagnostic *out) {
+    const char *marker = NULL;
+    size_t prefix_len = 0;
+
+    if(strncmp(line, "CMake Error at ", 15) == 0 || strncmp(line, "CMake Warning at ", 17) == 0){
+        out->is_error = line[6] == 'E';
+        line += out->is_error ? 15 : 17;
+        marker = strstr(line, " (");
+        if(!marker)
+            marker = line + strlen(line);
+        prefix_len = marker - line;
+        snprintf(out->message, sizeof(out->message), "%s", marker);
+    }
+    else{
+        const char *markers[] = {": fatal error", ": error", ": warning"};
+        for(size_t i = 0; i < sizeof(markers) / sizeof(markers[0]) && !marker; i++){
+            marker = strstr(line, markers[i]);
+            out->is_error = i < 2;
+        }
+        if(!marker || marker == line)
+            return false;
+        prefix_len = marker - line;
+        snprintf(out->message, sizeof(out->message), "%s", marker + 2);
+    }
+
+    char prefix[512];
+    if(prefix_len >= sizeof(prefix))
+        return false;
+    memcpy(prefix, line, prefix_len);
+    prefix[prefix_len] = '\0';
+
+    out->line = 0;
+    out->column = 0;
+
+    size_t len = strlen(prefix);
+    if(len > 0 && prefix[len - 1] == ')'){
+        // msvc style file(line) or file(line,col)
+        char *paren = strrchr(prefix, '(');
+        if(!paren || sscanf(paren, "(%d,%d)", &out->line, &out->column) < 1)
+            return false;
+        *paren = '\0';
+    }
+    else{
+        // walk back over up to two :number groups
+        for(int group = 0; group < 2; group++){
+            char *colon = strrchr(prefix, ':');
+            if(!colon || colon[1] < '0' || colon[1] > '9')
+                break;
+            out->column = out->line;
+            out->line = atoi(colon + 1);
+            *colon = '\0';
+        }
+    }
+
+    if(out->line <= 0 || prefix[0] == '\0')
+        return false;
+
+    // paths from the compiler can be relative to the build tree
+    bool is_abs = prefix[0] == '/' || (strlen(prefix) >= 2 && prefix[1] == ':');
+    if(is_abs)
+        snprintf(out->file, sizeof(out->file), "%s", prefix);
+    else
+        snprintf(out->file, sizeof(out->file), "%s/%s", build_dir, prefix);
+
+    return true;
+}
+
+static enum editor_log_kind build_line_cb(const char *line, void *userdata) {
+    struct editor_build_job *job = (struct editor_build_job *)userdata;
+
+    float step_progress;
+    if(build_parse_progress(line, &step_progress)){
+        SDL_LockMutex(EDITOR_STATE.build_mutex);
+        job->progress = job->progress_base + job->progress_span * step_progress;
+        if(job->interactive)
+            EDITOR_STATE.build_progress = job->progress;
+        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+    }
+
+    struct editor_build_diagnostic diag;
+    if(!build_parse_diagnostic(line, job->build_dir, &diag))
+        return EDITOR_LOG_NORMAL;
+
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    if(diag.is_error)
+        job->num_errors++;
+    else
+        job->num_warnings++;
+    if(job->interactive && editor_build_num_diagnostics < EDITOR_BUILD_MAX_DIAGNOSTICS)
+        editor_build_diagnostics[editor_build_num_diagnostics++] = diag;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+    return diag.is_error ? EDITOR_LOG_ERROR : EDITOR_LOG_WARNING;
+}
+
+/*
+    Cancellation
+
+    A job publishes the child it is currently waiting on, so the main
+    thread can kill it. cmake spawns make/ninja which spawn compilers,
+    killing only the direct child would leave the rest of the tree running.
+*/
+
+#ifdef __linux__
+struct build_proc_table {
+    int *pids;
+    int *ppids;
+    int count;
+    int capacity;
+};
+
+static SDL_EnumerationResult SDLCALL build_proc_scan_cb(void *userdata, const char *dirname, const char *fname) {
+    (void)dirname;
+    struct build_proc_table *table = (struct build_proc_table *)userdata;
+
+    char *end;
+    long pid = strtol(fname, &end, 10);
+    if(*end != '\0' || pid <= 0)
+        return SDL_ENUM_CONTINUE;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%ld/stat", pid);
+    char *stat = SDL_LoadFile(path, NULL);
+    if(!stat)
+        return SDL_ENUM_CONTINUE;
+
+    // "pid (comm) state ppid ...", comm may itself contain spaces and parens
+    int ppid = 0;
+    char *comm_end = strrchr(stat, ')');
+    if(comm_end && sscanf(comm_end + 1, " %*c %d", &ppid) == 1){
+        if(table->count == table->capacity){
+            int capacity = table->capacity ? table->capacity * 2 : 512;
+            int *pids = realloc(table->pids, capacity * sizeof(int));
+            if(pids)
+                table->pids = pids;
+            int *ppids = realloc(table->ppids, capacity * sizeof(int));
+            if(ppids)
+                table->ppids = ppids;
+
+            // out of memory, kill what we found so far
+            if(!pids || !ppids){
+                SDL_free(stat);
+                return SDL_ENUM_SUCCESS;
+            }
+            table->capacity = capacity;
+        }
+        table->pids[table->count] = (int)pid;
+        table->ppids[table->count] = ppid;
+        table->count++;
+    }
+    SDL_free(stat);
+    return SDL_ENUM_CONTINUE;
+}
+#endif
+
+/*
+    Kills the job's current child and everything below it. Only the pid is
+    read under build_mutex, the /proc walk (or the blocking taskkill) runs
+    without it so the worker's log callback is never stalled. The child
+    stays a zombie until the worker waits on it, so its pid cannot be
+    reused in between
+*/
+static void build_job_kill_process(struct editor_build_job *job) {
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    int root = job->process ? (int)SDL_GetNumberProperty(SDL_GetProcessProperties(job->process), SDL_PROP_PROCESS_PID_NUMBER, 0) : 0;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+    #ifdef _WIN32
+        if(root > 0){
+            char command[64];
+            snprintf(command, sizeof(command), "taskkill /T /F /PID %d >NUL 2>&1", root);
+            system(command);
+            return;
+        }
+    #elif defined(__linux__)
+        if(root > 0){
+            struct build_proc_table table = {0};
+            SDL_EnumerateDirectory("/proc", build_proc_scan_cb, &table);
+
+            /*
+                Collect the descendants breadth first and kill parents before
+                children, so nothing is left around to spawn replacements
+            */
+            int *tree = malloc((table.count + 1) * sizeof(int));
+            if(!tree){
+                kill(root, SIGKILL);
+                free(table.pids);
+                free(table.ppids);
+                return;
+            }
+            int tree_count = 0;
+            tree[tree_count++] = root;
+            for(int i = 0; i < tree_count; i++){
+                for(int j = 0; j < table.count; j++){
+                    if(table.ppids[j] == tree[i] && table.pids[j] != root)
+                        tree[tree_count++] = table.pids[j];
+                }
+            }
+            for(int i = 0; i < tree_count; i++)
+                kill(tree[i], SIGKILL);
+
+            free(tree);
+            free(table.pids);
+            free(table.ppids);
+            return;
+        }
+    #endif
+
+    // platforms without a tree walk only get the direct child
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    if(job->process)
+        SDL_KillProcess(job->process, true);
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+}
+
+static bool build_job_cancelled(struct editor_build_job *job) {
+    return SDL_GetAtomicInt(&job->cancel) != 0;
+}
+
+/*
+    Runs a child process to completion, streaming its combined
+    stdout/stderr into the build log. Returns the exit code, or -1 if
+    the process could not be started.
+*/
+static int build_run_process(struct editor_build_job *job, const char * const *argv) {
+    char cmdline[EDITOR_LOG_LINE_MAX] = "> ";
+    for(int i = 0; argv[i] != NULL; i++){
+        strncat(cmdline, argv[i], sizeof(cmdline) - strlen(cmdline) - 2);
+        strcat(cmdline, " ");
+    }
+    editor_log_ring_push(job->log, cmdline, EDITOR_LOG_NORMAL);
+
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ARGS_POINTER, (void *)argv);
+    SDL_SetNumberProperty(props, SDL_PROP_PROCESS_CREATE_STDOUT_NUMBER, SDL_PROCESS_STDIO_APP);
+    SDL_SetBooleanProperty(props, SDL_PROP_PROCESS_CREATE_STDERR_TO_STDOUT_BOOLEAN, true);
+    if(job->env)
+        SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ENVIRONMENT_POINTER, job->env);
+    SDL_Process *proc = SDL_CreateProcessWithProperties(props);
+    SDL_DestroyProperties(props);
+
+    if(!proc){
+        char msg[EDITOR_LOG_LINE_MAX];
+        snprintf(msg, sizeof(msg), "Failed to launch %s: %s", argv[0], SDL_GetError());
+        editor_log_ring_push(job->log, msg, EDITOR_LOG_ERROR);
+        return -1;
+    }
+
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    job->process = proc;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+    if(build_job_cancelled(job)) // cancelled between steps
+        build_job_kill_process(job);
+
+    SDL_IOStream *out = SDL_GetProcessOutput(proc);
+    char buf[4096];
+    while(out){
+        size_t read = SDL_ReadIO(out, buf, sizeof(buf));
+        if(read > 0){
+            editor_log_ring_write(job->log, buf, read, build_line_cb, job);
+            continue;
+        }
+        if(SDL_GetIOStatus(out) != SDL_IO_STATUS_NOT_READY)
+            break; // EOF or error, the child is done writing
+        SDL_Delay(10);
+    }
+    editor_log_ring_flush(job->log, build_line_cb, job);
+
+    int exitcode = -1;
+    SDL_WaitProcess(proc, true, &exitcode);
+
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    job->process = NULL;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+    SDL_DestroyProcess(proc);
+    return build_job_cancelled(job) ? -1 : exitcode;
+}
+
+/*
+    Compiler cache statistics
+
+    Read before and after the compile step and diffed, rather than zeroing
+    the counters, since the cache may be shared with other builds.
+*/
+static bool build_read_cache_counters(struct editor_build_job *job, long *hits, long *misses) {
+    bool is_ccache = strcmp(job->compiler_cache, "ccache") == 0;
+    const char *ccache_argv[] = {"ccache", "--print-stats", NULL};
+    const char *sccache_argv[] = {"sccache", "--show-stats", NULL};
+
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ARGS_POINTER, is_ccache ? (void *)ccache_argv : (void *)sccache_argv);
+    SDL_SetNumberProperty(props, SDL_PROP_PROCESS_CREATE_STDOUT_NUMBER, SDL_PROCESS_STDIO_APP);
+    if(job->env)
+        SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ENVIRONMENT_POINTER, job->env);
+    SDL_Process *proc = SDL_CreateProcessWithProperties(props);
+    SDL_DestroyProperties(props);
+    if(!proc)
+        return false;
+
+    int exitcode = -1;
+    char *output = SDL_ReadProcess(proc, NULL, &exitcode);
+    SDL_DestroyProcess(proc);
+    if(!output)
+        return false;
+
+    *hits = 0;
+    *misses = 0;
+    bool found = false;
+    char *save = NULL;
+    for(char *line = SDL_strtok_r(output, "\r\n", &save); line; line = SDL_strtok_r(NULL, "\r\n", &save)){
+        char key[64];
+        long value;
+        if(is_ccache){
+            // machine readable "key<TAB>value" lines
+            if(sscanf(line, "%63s %ld", key, &value) != 2)
+                continue;
+            if(strcmp(key, "direct_cache_hit") == 0 || strcmp(key, "preprocessed_cache_hit") == 0){
+                *hits += value;
+                found = true;
+            }
+            else if(strcmp(key, "cache_miss") == 0){
+                *misses += value;
+                found = true;
+            }
+        }
+        else{
+            // the totals, per language lines look like "Cache hits (C/C++)" and do not match
+            if(sscanf(line, "Cache hits %ld", &value) == 1){
+                *hits = value;
+                found = true;
+            }
+            else if(sscanf(line, "Cache misses %ld", &value) == 1){
+                *misses = value;
+                found = true;
+            }
+        }
+    }
+    SDL_free(output);
+    return found && exitcode == 0;
+}
+
+/*
+    No-op build detection
+
+    The fingerprint covers everything that can change the compiled output:
+    the configure arguments, build.yoyo, and the size/mtime of every file in
+    the project tree (and the local engine checkout, when one is used).
+    Content that only ends up in the packs (resources/) is left out.
+*/
+
+struct build_fingerprint_walk {
+    size_t root_len;
+    const char * const *root_excludes;
+    Uint64 sum;
+    Uint64 count;
+};
+
+static bool build_fingerprint_excluded(const char *name, const char * const *excludes) {
+    for(int i = 0; excludes[i] != NULL; i++){
+        if(strcmp(name, excludes[i]) == 0)
+            return true;
+    }
+    return false;
+}
+
+static SDL_EnumerationResult SDLCALL build_fingerprint_cb(void *userdata, const char *dirname, const char *fname) {
+    struct build_fingerprint_walk *walk = (struct build_fingerprint_walk *)userdata;
+
+    bool at_root = strlen(dirname) == walk->root_len;
+    if(strcmp(fname, ".git") == 0 || (at_root && build_fingerprint_excluded(fname, walk->root_excludes)))
+        return SDL_ENUM_CONTINUE;
+
+    size_t name_len = strlen(fname);
+    if(name_len > 4 && strcmp(fname + name_len - 4, ".yep") == 0)
+        return SDL_ENUM_CONTINUE;
+
+    char full[1024];
+    snprintf(full, sizeof(full), "%s%s", dirname, fname);
+
+    SDL_PathInfo info;
+    if(!SDL_GetPathInfo(full, &info))
+        return SDL_ENUM_CONTINUE;
+
+    if(info.type == SDL_PATHTYPE_DIRECTORY){
+        strncat(full, "/", sizeof(full) - strlen(full) - 1);
+        SDL_EnumerateDirectory(full, build_fingerprint_cb, walk);
+        return SDL_ENUM_CONTINUE;
+    }
+
+    const char *rel = full + walk->root_len;
+    Uint64 hash = editor_hash(EDITOR_HASH_SEED, rel, strlen(rel));
+    hash = editor_hash(hash, &info.size, sizeof(info.size));
+    hash = editor_hash(hash, &info.modify_time, sizeof(info.modify_time));
+
+    // summed, so the result does not depend on directory iteration order
+    walk->sum += hash;
+    walk->count++;
+    return SDL_ENUM_CONTINUE;
+}
+
+static Uint64 build_fingerprint_tree(Uint64 hash, const char *root, const char * const *root_excludes) {
+    char dir[1024];
+    snprintf(dir, sizeof(dir), "%s", root);
+    size_t len = strlen(dir);
+    if(len > 0 && dir[len - 1] != '/' && dir[len - 1] != '\\')
+        strncat(dir, "/", sizeof(dir) - len - 1);
+
+    struct build_fingerprint_walk walk = {0};
+    walk.root_len = strlen(dir);
+    walk.root_excludes = root_excludes;
+    SDL_EnumerateDirectory(dir, build_fingerprint_cb, &walk);
+
+    hash = editor_hash(hash, &walk.sum, sizeof(walk.sum));
+    return editor_hash(hash, &walk.count, sizeof(walk.count));
+}
+
+static void build_fingerprint(struct editor_build_job *job, char out[17]) {
+    Uint64 hash = EDITOR_HASH_SEED;
+
+    for(int i = 0; job->configure_argv[i] != NULL; i++){
+        // where the engine source came from does not change what it compiles to
+        if(strncmp(job->configure_argv[i], EDITOR_ENGINE_SOURCE_ARG, strlen(EDITOR_ENGINE_SOURCE_ARG)) == 0)
+            continue;
+        hash = editor_hash(hash, job->configure_argv[i], strlen(job->configure_argv[i]) + 1);
+    }
+
+    /*
+        Everything in build.yoyo that reaches the compile is in the configure
+        args hashed above. The file itself is left out, so editing keys the
+        compile never sees (max_jobs, pgo_seconds, the cache size...) keeps
+        the build a no-op
+    */
+    static const char * const project_excludes[] = {"build", "resources", "build.yoyo", NULL};
+    hash = build_fingerprint_tree(hash, job->project_root, project_excludes);
+
+    // engine sources are compiled into the game when building against a local checkout
+    const char *engine_arg = "-DYOYO_ENGINE_SOURCE_DIR=";
+    for(int i = 0; job->configure_argv[i] != NULL; i++){
+        if(strncmp(job->configure_argv[i], engine_arg, strlen(engine_arg)) == 0){
+            static const char * const engine_excludes[] = {"build", NULL};
+            hash = build_fingerprint_tree(hash, job->configure_argv[i] + strlen(engine_arg), engine_excludes);
+        }
+    }
+
+    snprintf(out, 17, "%016llx", (unsigned long long)hash);
+}
+
+static bool build_fingerprint_matches(struct editor_build_job *job, const char *fingerprint) {
+    size_t len = 0;
+    char *stored = SDL_LoadFile(job->fingerprint_path, &len);
+    if(!stored)
+        return false;
+
+    bool matches = len >= 16 && strncmp(stored, fingerprint, 16) == 0;
+    SDL_free(stored);
+    return matches;
+}
+
+static void build_fingerprint_store(struct editor_build_job *job, const char *fingerprint) {
+    SDL_SaveFile(job->fingerprint_path, fingerprint, strlen(fingerprint));
+}
+
+/*
+    Shared engine source
+
+    The first project to configure against an engine tag downloads it through
+    FetchContent as usual. Its checkout is then copied into the per user
+    engine cache, and later configures of any project are pointed at it
+    instead of downloading their own (see editor_build_prepare_job()).
+*/
+static void build_job_share_engine_source(struct editor_build_job *job) {
+    if(!job->engine_cache_dir[0] || SDL_GetPathInfo(job->engine_cache_dir, NULL))
+        return;
+
+    char fetched[1024];
+    snprintf(fetched, sizeof(fetched), "%s/_deps/yoyoengine-src", job->build_dir);
+    if(!SDL_GetPathInfo(fetched, NULL))
+        return;
+
+    // copied aside first, so a concurrent job or a crash never leaves a half written cache behind
+    char staging[1100];
+    snprintf(staging, sizeof(staging), "%s.%llx", job->engine_cache_dir, (unsigned long long)SDL_GetTicksNS());
+    if(!editor_copy_directory(fetched, staging) || !SDL_RenamePath(staging, job->engine_cache_dir)){
+        editor_remove_directory(staging);
+        return;
+    }
+
+    char line[EDITOR_LOG_LINE_MAX];
+    snprintf(line, sizeof(line), "Engine source cached at %s for other projects.", job->engine_cache_dir);
+    editor_log_ring_push(job->log, line, EDITOR_LOG_NORMAL);
+}
+
+/*
+    Parallelism
+
+    Picked right before the compile starts rather than when the build is
+    requested, so it sees the memory and pack work actually in flight. Each
+    compile job is budgeted EDITOR_BUILD_JOB_MB of memory (links and heavy
+    translation units peak well above the average), and every running pack
+    keeps a core for itself.
+*/
+static int build_job_pick_parallelism(struct editor_build_job *job) {
+    int cores = SDL_GetNumLogicalCPUCores();
+    int jobs = cores;
+
+    int packing = 0;
+    for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+        if(SDL_GetAtomicInt(&editor_pack_jobs[i].state) == EDITOR_PACK_RUNNING)
+            packing++;
+    }
+    jobs -= packing;
+
+    long available_mb = editor_available_memory_mb();
+    if(available_mb >= 0 && available_mb / EDITOR_BUILD_JOB_MB < jobs)
+        jobs = (int)(available_mb / EDITOR_BUILD_JOB_MB);
+
+    if(job->job_share > 1)
+        jobs /= job->job_share;
+    if(job->max_jobs > 0 && jobs > job->max_jobs)
+        jobs = job->max_jobs;
+    if(jobs < 1)
+        jobs = 1;
+
+    char line[EDITOR_LOG_LINE_MAX];
+    snprintf(line, sizeof(line), "Compiling with %d jobs (%d cores, %ld MiB available, %d packs running%s)",
+        jobs, cores, available_mb, packing, job->max_jobs > 0 ? ", capped by build.yoyo" : "");
+    editor_log_ring_push(job->log, line, EDITOR_LOG_NORMAL);
+    return jobs;
+}
+
+/*
+    Build steps, each returns 0 on success, 3 if the job was cancelled and
+    2 (with the failure status already set) otherwise
+*/
+static int build_job_configure(struct editor_build_job *job, float progress) {
+    build_job_set_status(job, 0, progress, "Running CMake ...");
+    job->progress_base = progress;
+    job->progress_span = 0.0f;
+    Uint64 configure_start = SDL_GetTicks();
+    int configure_result = build_run_process(job, (const char * const *)job->configure_argv);
+    job->configure_seconds += (SDL_GetTicks() - configure_start) / 1000.0f;
+    if(configure_result != 0){
+        if(build_job_cancelled(job))
+            return 3;
+        build_job_set_status(job, 2, 1.0f, "CMake configure failed.");
+        return 2;
+    }
+
+    build_job_share_engine_source(job);
+    return 0;
+}
+
+static int build_job_compile(struct editor_build_job *job, float progress_base, float progress_span, const char *status) {
+    build_job_set_status(job, 0, progress_base, status);
+    job->progress_base = progress_base;
+    job->progress_span = progress_span;
+    long hits_before = 0, misses_before = 0;
+    bool have_cache_counters = job->compiler_cache[0] && build_read_cache_counters(job, &hits_before, &misses_before);
+
+    job->parallel_jobs = build_job_pick_parallelism(job);
+    char parallel[16];
+    snprintf(parallel, sizeof(parallel), "%d", job->parallel_jobs);
+    const char *build_argv[] = {"cmake", "--build", job->build_dir, "--parallel", parallel, NULL};
+    Uint64 compile_start = SDL_GetTicks();
+    int compile_result = build_run_process(job, build_argv);
+    job->compile_seconds += (SDL_GetTicks() - compile_start) / 1000.0f;
+
+    long hits_after = 0, misses_after = 0;
+    if(have_cache_counters && build_read_cache_counters(job, &hits_after, &misses_after)){
+        if(job->interactive){
+            SDL_LockMutex(EDITOR_STATE.build_mutex);
+            editor_build_cache_stats.valid = true;
+            editor_build_cache_stats.hits = hits_after - hits_before;
+            editor_build_cache_stats.misses = misses_after - misses_before;
+            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+        }
+
+        char line[EDITOR_LOG_LINE_MAX];
+        long total = (hits_after - hits_before) + (misses_after - misses_before);
+        snprintf(line, sizeof(line), "%s: %ld hits, %ld misses (%.0f%% hit rate)", job->compiler_cache,
+            hits_after - hits_before, misses_after - misses_before, total > 0 ? 100.0 * (hits_after - hits_before) / total : 0.0);
+        editor_log_ring_push(job->log, line, EDITOR_LOG_NORMAL);
+    }
+    if(compile_result != 0){
+        if(build_job_cancelled(job))
+            return 3;
+        build_job_set_status(job, 2, 1.0f, "Compilation failed.");
+        return 2;
+    }
+    return 0;
+}
+
+/*
+    Profile guided optimization
+
+    Three phases in the one build tree: an instrumented build, a training
+    run of the game that leaves .gcda profiles next to the objects, and an
+    optimized rebuild that reads them back. Staying in the same tree keeps
+    the object paths (which the profiles are keyed by) identical between
+    phases. The flags are GCC's, clang would need an llvm-profdata merge.
+*/
+#define BUILD_PGO_GENERATE_FLAGS "-fprofile-generate -fprofile-update=atomic"
+#define BUILD_PGO_USE_FLAGS "-fprofile-use -fprofile-correction -Wno-missing-profile"
+
+// seconds the game gets to exit on its own (and write its profile) before it is killed
+#define BUILD_PGO_EXIT_GRACE 10
+
+// swaps the phase flags into the -DCMAKE_C_FLAGS= configure arg
+static void build_pgo_set_cflags(struct editor_build_job *job, const char *base, const char *flags) {
+    for(int i = 0; job->configure_argv[i] != NULL; i++){
+        if(strncmp(job->configure_argv[i], "-DCMAKE_C_FLAGS=", strlen("-DCMAKE_C_FLAGS=")) != 0)
+            continue;
+
+        size_t len = strlen("-DCMAKE_C_FLAGS=") + strlen(base) + strlen(flags) + 2;
+        char *arg = malloc(len);
+        snprintf(arg, len, "-DCMAKE_C_FLAGS=%s%s%s", base, base[0] ? " " : "", flags);
+        free(job->configure_argv[i]);
+        job->configure_argv[i] = arg;
+        return;
+    }
+}
+
+static SDL_EnumerationResult SDLCALL build_pgo_remove_profiles_cb(void *userdata, const char *dirname, const char *fname) {
+    char path[1024];
+    snprintf(path, sizeof(path), "%s%s", dirname, fname);
+
+    SDL_PathInfo info;
+    if(!SDL_GetPathInfo(path, &info))
+        return SDL_ENUM_CONTINUE;
+
+    if(info.type == SDL_PATHTYPE_DIRECTORY){
+        strncat(path, "/", sizeof(path) - strlen(path) - 1);
+        SDL_EnumerateDirectory(path, build_pgo_remove_profiles_cb, userdata);
+    }
+    else{
+        size_t len = strlen(fname);
+        if(len > 5 && strcmp(fname + len - 5, ".gcda") == 0)
+            SDL_RemovePath(path);
+    }
+    return SDL_ENUM_CONTINUE;
+}
+
+/*
+    Runs the instrumented game for pgo_seconds, then asks it to quit. SIGTERM
+    turns into a regular quit event inside SDL, so the game exits normally
+    and the profiling runtime gets to write out its counters
+*/
+static int build_job_pgo_train(struct editor_build_job *job) {
+    if(!ye_file_exists(job->exe_path)){
+        editor_log_ring_push(job->log, "The instrumented build produced no executable.", EDITOR_LOG_ERROR);
+        build_job_set_status(job, 2, 1.0f, "Instrumented build has no executable.");
+        return 2;
+    }
+
+    // the game cannot start without its packs
+    if(editor_pack_is_running()){
+        build_job_set_status(job, 0, 0.4f, "Waiting for packs ...");
+        editor_pack_await();
+    }
+
+    // counters from an older training run would be merged into this one
+    char build_dir[1100];
+    snprintf(build_dir, sizeof(build_dir), "%s/", job->build_dir);
+    SDL_EnumerateDirectory(build_dir, build_pgo_remove_profiles_cb, NULL);
+
+    char status[256];
+    snprintf(status, sizeof(status), "Training for %ds ...", job->pgo_seconds);
+    build_job_set_status(job, 0, 0.4f, status);
+
+    // trains on the entry scene, the engine has no way to start the game in another one
+    const char *argv[] = {job->exe_path, NULL};
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ARGS_POINTER, (void *)argv);
+    SDL_SetNumberProperty(props, SDL_PROP_PROCESS_CREATE_STDOUT_NUMBER, SDL_PROCESS_STDIO_APP);
+    SDL_SetBooleanProperty(props, SDL_PROP_PROCESS_CREATE_STDERR_TO_STDOUT_BOOLEAN, true);
+    SDL_Process *proc = SDL_CreateProcessWithProperties(props);
+    SDL_DestroyProperties(props);
+
+    if(!proc){
+        char msg[EDITOR_LOG_LINE_MAX];
+        snprintf(msg, sizeof(msg), "Failed to launch the training run: %s", SDL_GetError());
+        editor_log_ring_push(job->log, msg, EDITOR_LOG_ERROR);
+        build_job_set_status(job, 2, 1.0f, "Training run failed to start.");
+        return 2;
+    }
+
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    job->process = proc;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+    if(build_job_cancelled(job))
+        build_job_kill_process(job);
+
+    Uint64 start = SDL_GetTicks();
+    Uint64 deadline = start + (Uint64)job->pgo_seconds * 1000;
+    bool asked_to_quit = false;
+    bool killed = false;
+    SDL_IOStream *out = SDL_GetProcessOutput(proc);
+    char buf[4096];
+    while(out){
+        size_t read = SDL_ReadIO(out, buf, sizeof(buf));
+        if(read > 0){
+            editor_log_ring_write(job->log, buf, read, NULL, NULL);
+            continue;
+        }
+        if(SDL_GetIOStatus(out) != SDL_IO_STATUS_NOT_READY)
+            break; // the game exited
+
+        Uint64 now = SDL_GetTicks();
+        if(!asked_to_quit && now >= deadline){
+            SDL_KillProcess(proc, false);
+            asked_to_quit = true;
+        }
+        else if(asked_to_quit && !killed && now >= deadline + BUILD_PGO_EXIT_GRACE * 1000){
+            // once, a game slow to die would otherwise flood the log until EOF
+            editor_log_ring_push(job->log, "The game did not quit in time, its profile is likely incomplete.", EDITOR_LOG_WARNING);
+            SDL_KillProcess(proc, true);
+            killed = true;
+        }
+        else if(!asked_to_quit){
+            SDL_LockMutex(EDITOR_STATE.build_mutex);
+            job->progress = 0.4f + 0.15f * (now - start) / (float)(deadline - start);
+            if(job->interactive)
+                EDITOR_STATE.build_progress = job->progress;
+            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+        }
+        SDL_Delay(10);
+    }
+    editor_log_ring_flush(job->log, NULL, NULL);
+
+    int exitcode = -1;
+    SDL_WaitProcess(proc, true, &exitcode);
+
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    job->process = NULL;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+    SDL_DestroyProcess(proc);
+
+    if(build_job_cancelled(job))
+        return 3;
+
+    // a crash mid run still leaves usable counters from before it, so keep going
+    if(!asked_to_quit || exitcode != 0){
+        char msg[EDITOR_LOG_LINE_MAX];
+        snprintf(msg, sizeof(msg), "Training run ended early (exit code %d), optimizing with what was recorded.", exitcode);
+        editor_log_ring_push(job->log, msg, EDITOR_LOG_WARNING);
+    }
+    return 0;
+}
+
+static int build_job_pgo(struct editor_build_job *job) {
+    char base_cflags[1024] = "";
+    for(int i = 0; job->configure_argv[i] != NULL; i++){
+        if(strncmp(job->configure_argv[i], "-DCMAKE_C_FLAGS=", strlen("-DCMAKE_C_FLAGS=")) == 0)
+            snprintf(base_cflags, sizeof(base_cflags), "%s", job->configure_argv[i] + strlen("-DCMAKE_C_FLAGS="));
+    }
+
+    editor_log_ring_push(job->log, "PGO 1/3: instrumented build", EDITOR_LOG_NORMAL);
+    build_pgo_set_cflags(job, base_cflags, BUILD_PGO_GENERATE_FLAGS);
+    int result = build_job_configure(job, 0.05f);
+    if(result == 0)
+        result = build_job_compile(job, 0.05f, 0.35f, "Building instrumented ...");
+    if(result != 0)
+        return result;
+
+    editor_log_ring_push(job->log, "PGO 2/3: training run", EDITOR_LOG_NORMAL);
+    result = build_job_pgo_train(job);
+    if(result != 0)
+        return result;
+
+    editor_log_ring_push(job->log, "PGO 3/3: optimized build", EDITOR_LOG_NORMAL);
+    build_pgo_set_cflags(job, base_cflags, BUILD_PGO_USE_FLAGS);
+    result = build_job_configure(job, 0.55f);
+    if(result == 0)
+        result = build_job_compile(job, 0.55f, 0.45f, "Building optimized ...");
+    return result;
+}
+
+static int build_job_thread(void *userdata) {
+    struct editor_build_job *job = (struct editor_build_job *)userdata;
+    int ret = 1;
+
+    if(job->compiler_cache[0]){
+        job->env = SDL_CreateEnvironment(true);
+        if(strcmp(job->compiler_cache, "ccache") == 0){
+            if(job->compiler_cache_size[0])
+                SDL_SetEnvironmentVariable(job->env, "CCACHE_MAXSIZE", job->compiler_cache_size, true);
+
+            /*
+                Paths inside the project (the build tree) are hashed relative to
+                the compile's working directory and the directory itself is left
+                out, so engine objects compiled from the shared engine source hit
+                the cache from every project, not just the one that filled it
+            */
+            SDL_SetEnvironmentVariable(job->env, "CCACHE_BASEDIR", job->project_root, true);
+            SDL_SetEnvironmentVariable(job->env, "CCACHE_NOHASHDIR", "1", true);
+        }
+        else if(job->compiler_cache_size[0]){
+            SDL_SetEnvironmentVariable(job->env, "SCCACHE_CACHE_SIZE", job->compiler_cache_size, true);
+        }
+    }
+
+    /*
+        Everything below works on absolute paths (cmake -S/-B, --build <dir>),
+        the process wide working directory is never touched so any number of
+        jobs can run side by side
+    */
+    ye_mkdir(job->build_dir);
+
+    bool cmake_cache_exists = ye_file_exists(job->cmake_cache_path);
+
+    // skip cmake entirely when nothing that feeds the compile has changed
+    build_job_set_status(job, 0, 0.02f, "Checking for changes ...");
+    char fingerprint[17];
+    build_fingerprint(job, fingerprint);
+    if(!job->force_configure && cmake_cache_exists &&
+       ye_file_exists(job->exe_path) && build_fingerprint_matches(job, fingerprint)){
+        editor_log_ring_push(job->log, "Sources unchanged since the last build, skipping CMake.", EDITOR_LOG_NORMAL);
+        goto packs;
+    }
+
+    // a failed or interrupted build must not leave a fingerprint claiming it is current
+    SDL_RemovePath(job->fingerprint_path);
+
+    if(job->pgo){
+        int result = build_job_pgo(job);
+        if(result == 3)
+            goto cancelled;
+        if(result != 0)
+            goto cleanup;
+    }
+    else{
+        // CMake step
+        if (job->force_configure || !cmake_cache_exists) {
+            int result = build_job_configure(job, 0.05f);
+            if(result == 3)
+                goto cancelled;
+            if(result != 0)
+                goto cleanup;
+        }
+
+        // Build step
+        int result = build_job_compile(job, 0.2f, 0.8f, "Building ...");
+        if(result == 3)
+            goto cancelled;
+        if(result != 0)
+            goto cleanup;
+    }
+
+    // computed before the build, so edits made while compiling still count as changes next time
+    build_fingerprint_store(job, fingerprint);
+
+packs:
+    // packs were started alongside cmake, the game cannot run without them
+    if(job->wait_for_packs && editor_pack_is_running() && !build_job_cancelled(job)){
+        build_job_set_status(job, 0, 1.0f, "Waiting for packs ...");
+        editor_pack_await();
+    }
+
+    if(build_job_cancelled(job))
+        goto cancelled;
+
+    /*
+        What the build ships, diffed against the previous build. The packs
+        are part of it, so they have to be finished first
+    */
+    if(job->interactive){
+        build_job_set_status(job, 0, 1.0f, "Measuring sizes ...");
+        if(editor_pack_is_running())
+            editor_pack_await();
+        editor_size_report_generate(job->exe_path, job->build_dir, job->project_root);
+    }
+
+    build_job_set_status(job, 1, 1.0f, "done");
+    ret = 0;
+    goto cleanup;
+
+cancelled:
+    editor_log_ring_push(job->log, "Build cancelled.", EDITOR_LOG_WARNING);
+    build_job_set_status(job, 3, 1.0f, "Build cancelled.");
+
+cleanup:
+    if(job->env){
+        SDL_DestroyEnvironment(job->env);
+        job->env = NULL;
+    }
+    job->end_ticks = SDL_GetTicks();
+    return ret;
+}
+
+/*
+    Job lifecycle
+*/
+
+struct editor_build_job * editor_build_job_create(bool interactive) {
+    struct editor_build_job *job = calloc(1, sizeof(struct editor_build_job));
+    if(!job)
+        return NULL;
+
+    job->interactive = interactive;
+    if(interactive){
+        job->log = &editor_build_log;
+    }
+    else{
+        editor_log_ring_init(&job->own_log, EDITOR_BUILD_LOG_LINES);
+        job->log = &job->own_log;
+    }
+    return job;
+}
+
+bool editor_build_job_start(struct editor_build_job *job) {
+    SDL_SetAtomicInt(&job->cancel, 0);
+    job->start_ticks = SDL_GetTicks();
+    job->end_ticks = 0;
+    job->num_errors = 0;
+    job->num_warnings = 0;
+    build_job_set_status(job, 0, 0.0f, "Starting build ...");
+
+    job->thread = SDL_CreateThread(build_job_thread, "BuildThread", job);
+    if(job->thread == NULL){
+        build_job_set_status(job, 2, 1.0f, "Failed to start the build thread.");
+        return false;
+    }
+    return true;
+}
+
+int editor_build_job_status(struct editor_build_job *job) {
+    SDL_LockMutex(EDITOR_STATE.build_mutex);
+    int status = job->status;
+    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+    return status;
+}
+
+void editor_build_job_cancel(struct editor_build_job *job) {
+    SDL_SetAtomicInt(&job->cancel, 1);
+    build_job_kill_process(job);
+}
+
+void editor_build_job_destroy(struct editor_build_job *job) {
+    if(!job)
+        return;
+
+    if(job->thread)
+        SDL_WaitThread(job->thread, NULL);
+
+    if(job->configure_argv){
+        for(int i = 0; job->configure_argv[i] != NULL; i++)
+            free(job->configure_argv[i]);
+        free(job->configure_argv);
+    }
+
+    if(!job->interactive)
+        editor_log_ring_destroy(&job->own_log);
+    free(job);
+}
@@ -0,0 +1,256 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifdef __linux__
+    #include <unistd.h>
+#endif
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_game.h"
+
+struct editor_game_state editor_game;
+struct editor_log_ring editor_game_log;
+
+static SDL_Mutex *game_mutex = NULL;
+
+// owned by the main thread, the supervisor only uses it while it runs
+static SDL_Process *game_process = NULL;
+static SDL_Thread *game_thread = NULL;
+static SDL_AtomicInt game_exited;
+
+void editor_game_lock(){
+    SDL_LockMutex(game_mutex);
+}
+
+void editor_game_unlock(){
+    SDL_UnlockMutex(game_mutex);
+}
+
+/*
+    Process stats
+*/
+
+struct game_cpu_clock {
+    Uint64 cpu_ticks;   // utime + stime of the game, in clock ticks
+    Uint64 wall_ticks;  // SDL_GetTicks() when cpu_ticks was read
+    bool valid;
+};
+
+#ifdef __linux__
+// fields of /proc/<pid>/stat after the command name, which may itself contain spaces
+static bool game_read_proc_stat(Sint64 pid, Uint64 *cpu_ticks, long *rss_pages, long *threads){
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%lld/stat", (long long)pid);
+
+    FILE *stat = fopen(path, "r");
+    if(!stat)
+        return false;
+
+    char buf[1024];
+    size_t len = fread(buf, 1, sizeof(buf) - 1, stat);
+    fclose(stat);
+    buf[len] = '\0';
+
+    char *fields = strrchr(buf, ')');
+    if(!fields)
+        return false;
+
+    // 14 utime, 15 stime, 20 num_threads, 24 rss (see proc(5))
+    unsigned long utime = 0, stime = 0;
+    if(sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %*d %*d %ld %*d %*u %*u %ld",
+              &utime, &stime, threads, rss_pages) != 4)
+        return false;
+
+    *cpu_ticks = (Uint64)utime + stime;
+    return true;
+}
+#endif
+
+static void game_take_sample(Sint64 pid, struct game_cpu_clock *clock){
+#ifdef __linux__
+    Uint64 cpu_ticks = 0;
+    long rss_pages = 0, threads = 0;
+    if(!game_read_proc_stat(pid, &cpu_ticks, &rss_pages, &threads))
+        return;
+
+    Uint64 now = SDL_GetTicks();
+    struct editor_game_sample sample = {0};
+    if(clock->valid && now > clock->wall_ticks){
+        float cpu_seconds = (cpu_ticks - clock->cpu_ticks) / (float)sysconf(_SC_CLK_TCK);
+        sample.cpu_percent = 100.0f * cpu_seconds / ((now - clock->wall_ticks) / 1000.0f);
+    }
+    sample.rss_mb = rss_pages * (float)sysconf(_SC_PAGESIZE) / (1024.0f * 1024.0f);
+    sample.threads = (int)threads;
+
+    clock->cpu_ticks = cpu_ticks;
+    clock->wall_ticks = now;
+    clock->valid = true;
+
+    editor_game_lock();
+    sample.seconds = (now - editor_game.start_ticks) / 1000.0f;
+    if(editor_game.num_samples == EDITOR_GAME_MAX_SAMPLES){
+        memmove(&editor_game.samples[0], &editor_game.samples[1], (EDITOR_GAME_MAX_SAMPLES - 1) * sizeof(struct editor_game_sample));
+        editor_game.num_samples--;
+    }
+    editor_game.samples[editor_game.num_samples++] = sample;
+    editor_game_unlock();
+#else
+    (void)pid;
+    (void)clock;
+#endif
+}
+
+/*
+    Supervisor
+*/
+
+static int game_supervisor_thread(void *data){
+    SDL_Process *proc = (SDL_Process *)data;
+
+    editor_game_lock();
+    Sint64 pid = editor_game.pid;
+    editor_game_unlock();
+
+    struct game_cpu_clock clock = {0};
+    Uint64 next_sample = SDL_GetTicks();
+    SDL_IOStream *out = SDL_GetProcessOutput(proc);
+    char buf[4096];
+
+    bool exited = false;
+    int exit_code = -1;
+    while(!exited){
+        bool got_output = false;
+        if(out){
+            size_t read = SDL_ReadIO(out, buf, sizeof(buf));
+            if(read > 0){
+                editor_log_ring_write(&editor_game_log, buf, read, NULL, NULL);
+                got_output = true;
+            }
+            else if(SDL_GetIOStatus(out) != SDL_IO_STATUS_NOT_READY){
+                out = NULL; // the game closed its output, keep sampling until it exits
+            }
+        }
+
+        if(SDL_GetTicks() >= next_sample){
+            game_take_sample(pid, &clock);
+            next_sample = SDL_GetTicks() + EDITOR_GAME_SAMPLE_MS;
+        }
+
+        exited = SDL_WaitProcess(proc, false, &exit_code);
+
+        // a chatty game is drained as fast as it writes, otherwise it would block on a full pipe
+        if(!got_output && !exited)
+            SDL_Delay(10);
+    }
+
+    // whatever was written right before exiting
+    out = SDL_GetProcessOutput(proc);
+    size_t read;
+    while(out && (read = SDL_ReadIO(out, buf, sizeof(buf))) > 0)
+        editor_log_ring_write(&editor_game_log, buf, read, NULL, NULL);
+    editor_log_ring_flush(&editor_game_log, NULL, NULL);
+
+    editor_game_lock();
+    editor_game.running = false;
+    editor_game.exit_code = exit_code;
+    editor_game.end_ticks = SDL_GetTicks();
+    editor_game_unlock();
+
+    SDL_SetAtomicInt(&game_exited, 1);
+    return 0;
+}
+
+// joins the supervisor and releases the process, expects the game to have exited
+static void game_reap(){
+    SDL_WaitThread(game_thread, NULL);
+    game_thread = NULL;
+    SDL_DestroyProcess(game_process);
+    game_process = NULL;
+
+    EDITOR_STATE.is_running = false;
+    EDITOR_STATE.running_thread = NULL;
+
+    editor_game_lock();
+    ye_logf(info, "Game exited with code %d after %.1fs.\n", editor_game.exit_code, (editor_game.end_ticks - editor_game.start_ticks) / 1000.0f);
+    editor_game_unlock();
+}
+
+void editor_game_init(){
+    game_mutex = SDL_CreateMutex();
+    editor_log_ring_init(&editor_game_log, EDITOR_GAME_LOG_LINES);
+}
+
+void editor_game_shutdown(){
+    // the game writes into a pipe that goes away with us
+    if(game_thread){
+        editor_game_stop(true);
+        game_reap();
+    }
+    editor_log_ring_destroy(&editor_game_log);
+    SDL_DestroyMutex(game_mutex);
+    game_mutex = NULL;
+}
+
+void editor_game_attach(SDL_Process *proc){
+    // one game at a time, a new run replaces the old one
+    if(game_thread){
+        ye_logf(info, "Stopping the running game before launching a new one.\n");
+        editor_game_stop(true);
+        game_reap();
+    }
+
+    editor_log_ring_clear(&editor_game_log);
+
+    editor_game_lock();
+    editor_game.launched = true;
+    editor_game.running = true;
+    #ifdef __linux__
+        editor_game.can_sample = true;
+    #else
+        editor_game.can_sample = false;
+    #endif
+    editor_game.pid = SDL_GetNumberProperty(SDL_GetProcessProperties(proc), SDL_PROP_PROCESS_PID_NUMBER, 0);
+    editor_game.exit_code = 0;
+    editor_game.start_ticks = SDL_GetTicks();
+    editor_game.end_ticks = 0;
+    editor_game.num_samples = 0;
+    editor_game_unlock();
+
+    game_process = proc;
+    SDL_SetAtomicInt(&game_exited, 0);
+    game_thread = SDL_CreateThread(game_supervisor_thread, "GameSupervisor", proc);
+    if(game_thread == NULL){
+        ye_logf(error, "Failed to supervise the game: %s\n", SDL_GetError());
+        SDL_DestroyProcess(proc);
+        game_process = NULL;
+        editor_game_lock();
+        editor_game.running = false;
+        editor_game_unlock();
+        return;
+    }
+
+    EDITOR_STATE.is_running = true;
+    EDITOR_STATE.running_thread = game_thread;
+}
+
+void editor_game_stop(bool force){
+    if(game_process && !SDL_GetAtomicInt(&game_exited))
+        SDL_KillProcess(game_process, force);
+}
+
+void editor_game_poll(){
+    if(game_thread && SDL_GetAtomicInt(&game_exited))
+        game_reap();
+}
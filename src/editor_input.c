@@ -184,7 +184,6 @@ void editor_input_shortcuts(SDL_Event event){
             if (event.key.mod & SDL_KMOD_CTRL)
             {
                 editor_write_scene_to_disk(ye_path_resources(YE_STATE.runtime.scene_file_path));
-                editor_saved();
             }
             break;
         case SDLK_R :
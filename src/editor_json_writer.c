@@ -0,0 +1,306 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <jansson.h>
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_json_writer.h"
+
+#define EDITOR_JSON_WRITER_INDENT 4
+
+void editor_json_writer_init(struct editor_json_writer *writer, SDL_IOStream *io, int base_depth){
+    memset(writer, 0, sizeof(*writer));
+    writer->io = io;
+    writer->base_depth = base_depth;
+    writer->depth = base_depth;
+}
+
+static bool editor_json_writer_flush(struct editor_json_writer *writer){
+    if(!writer->io || writer->len == 0)
+        return !writer->failed;
+
+    if(SDL_WriteIO(writer->io, writer->buf, writer->len) != writer->len)
+        writer->failed = true;
+    writer->len = 0;
+    return !writer->failed;
+}
+
+static void editor_json_writer_append(struct editor_json_writer *writer, const char *data, size_t len){
+    if(writer->failed)
+        return;
+
+    if(writer->len + len + 1 > writer->cap){
+        // streaming writers never grow past the buffer size, unless one write alone is bigger
+        if(writer->io && writer->len > 0 && !editor_json_writer_flush(writer))
+            return;
+
+        if(writer->len + len + 1 > writer->cap){
+            size_t cap = writer->cap ? writer->cap : EDITOR_JSON_WRITER_BUFFER;
+            while(cap < writer->len + len + 1)
+                cap *= 2;
+            char *buf = realloc(writer->buf, cap);
+            if(!buf){
+                writer->failed = true;
+                return;
+            }
+            writer->buf = buf;
+            writer->cap = cap;
+        }
+    }
+
+    memcpy(writer->buf + writer->len, data, len);
+    writer->len += len;
+}
+
+static void editor_json_writer_indent(struct editor_json_writer *writer, int depth){
+    static const char spaces[] = "                                ";
+    editor_json_writer_append(writer, "\n", 1);
+
+    int count = depth * EDITOR_JSON_WRITER_INDENT;
+    while(count > 0){
+        int chunk = count < (int)sizeof(spaces) - 1 ? count : (int)sizeof(spaces) - 1;
+        editor_json_writer_append(writer, spaces, chunk);
+        count -= chunk;
+    }
+}
+
+// separator and line break before a value or key, like jansson's dump_indent()
+static void editor_json_writer_item(struct editor_json_writer *writer){
+    if(writer->after_key){
+        writer->after_key = false;
+        return;
+    }
+
+    // the first value of a writer is where the caller put it
+    if(writer->depth == writer->base_depth)
+        return;
+
+    if(writer->has_items[writer->depth])
+        editor_json_writer_append(writer, ",", 1);
+    writer->has_items[writer->depth] = true;
+    editor_json_writer_indent(writer, writer->depth);
+}
+
+static void editor_json_writer_open(struct editor_json_writer *writer, char bracket){
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, &bracket, 1);
+
+    if(writer->depth + 1 >= EDITOR_JSON_WRITER_MAX_DEPTH){
+        writer->failed = true;
+        return;
+    }
+    writer->depth++;
+    writer->has_items[writer->depth] = false;
+}
+
+static void editor_json_writer_close(struct editor_json_writer *writer, char bracket){
+    if(writer->depth <= writer->base_depth){
+        writer->failed = true;
+        return;
+    }
+
+    // empty containers stay on one line
+    if(writer->has_items[writer->depth])
+        editor_json_writer_indent(writer, writer->depth - 1);
+    writer->depth--;
+    editor_json_writer_append(writer, &bracket, 1);
+}
+
+void editor_json_writer_begin_object(struct editor_json_writer *writer){
+    editor_json_writer_open(writer, '{');
+}
+
+void editor_json_writer_end_object(struct editor_json_writer *writer){
+    editor_json_writer_close(writer, '}');
+}
+
+void editor_json_writer_begin_array(struct editor_json_writer *writer){
+    editor_json_writer_open(writer, '[');
+}
+
+void editor_json_writer_end_array(struct editor_json_writer *writer){
+    editor_json_writer_close(writer, ']');
+}
+
+// jansson escapes the same characters, anything else (including utf-8) goes out as is
+static void editor_json_writer_quoted(struct editor_json_writer *writer, const char *str){
+    editor_json_writer_append(writer, "\"", 1);
+
+    const char *run = str;
+    for(const char *c = str; *c; c++){
+        unsigned char ch = (unsigned char)*c;
+        const char *escape = NULL;
+        char unicode[8];
+
+        switch(ch){
+            case '"':  escape = "\\\""; break;
+            case '\\': escape = "\\\\"; break;
+            case '\b': escape = "\\b"; break;
+            case '\f': escape = "\\f"; break;
+            case '\n': escape = "\\n"; break;
+            case '\r': escape = "\\r"; break;
+            case '\t': escape = "\\t"; break;
+            default:
+                if(ch < 0x20){
+                    snprintf(unicode, sizeof(unicode), "\\u%04X", ch);
+                    escape = unicode;
+                }
+        }
+
+        if(!escape)
+            continue;
+
+        editor_json_writer_append(writer, run, c - run);
+        editor_json_writer_append(writer, escape, strlen(escape));
+        run = c + 1;
+    }
+    editor_json_writer_append(writer, run, strlen(run));
+
+    editor_json_writer_append(writer, "\"", 1);
+}
+
+void editor_json_writer_key(struct editor_json_writer *writer, const char *key){
+    editor_json_writer_item(writer);
+    editor_json_writer_quoted(writer, key);
+    editor_json_writer_append(writer, ": ", 2);
+    writer->after_key = true;
+}
+
+void editor_json_writer_string(struct editor_json_writer *writer, const char *value){
+    editor_json_writer_item(writer);
+    editor_json_writer_quoted(writer, value ? value : "");
+}
+
+void editor_json_writer_integer(struct editor_json_writer *writer, long long value){
+    char text[32];
+    int len = snprintf(text, sizeof(text), "%lld", value);
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, text, len);
+}
+
+/*
+    Same text as jansson: 17 significant digits, always a ".0" or an
+    exponent so it reads back as a real, exponents without "+" or leading
+    zeros. jansson cannot hold nan/inf at all, those are written as 0.0
+*/
+void editor_json_writer_real(struct editor_json_writer *writer, double value){
+    if(!isfinite(value))
+        value = 0.0;
+
+    char text[48];
+    int len = snprintf(text, sizeof(text), "%.17g", value);
+
+    if(!strchr(text, '.') && !strchr(text, 'e')){
+        memcpy(text + len, ".0", 3);
+        len += 2;
+    }
+
+    char *exponent = strchr(text, 'e');
+    if(exponent){
+        char *start = exponent + 1;
+        char *digits = start;
+        if(*digits == '+')
+            digits++;
+        else if(*digits == '-'){
+            digits++;
+            start++;
+        }
+        while(*digits == '0' && digits[1] != '\0')
+            digits++;
+        memmove(start, digits, strlen(digits) + 1);
+        len = (int)strlen(text);
+    }
+
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, text, len);
+}
+
+void editor_json_writer_boolean(struct editor_json_writer *writer, bool value){
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, value ? "true" : "false", value ? 4 : 5);
+}
+
+void editor_json_writer_null(struct editor_json_writer *writer){
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, "null", 4);
+}
+
+void editor_json_writer_fragment(struct editor_json_writer *writer, const char *text, size_t len){
+    editor_json_writer_item(writer);
+    editor_json_writer_append(writer, text, len);
+}
+
+void editor_json_writer_value(struct editor_json_writer *writer, json_t *value){
+    const char *key;
+    json_t *item;
+    size_t index;
+
+    switch(json_typeof(value)){
+        case JSON_OBJECT:
+            editor_json_writer_begin_object(writer);
+            json_object_foreach(value, key, item){
+                editor_json_writer_key(writer, key);
+                editor_json_writer_value(writer, item);
+            }
+            editor_json_writer_end_object(writer);
+            break;
+        case JSON_ARRAY:
+            editor_json_writer_begin_array(writer);
+            json_array_foreach(value, index, item)
+                editor_json_writer_value(writer, item);
+            editor_json_writer_end_array(writer);
+            break;
+        case JSON_STRING:
+            editor_json_writer_string(writer, json_string_value(value));
+            break;
+        case JSON_INTEGER:
+            editor_json_writer_integer(writer, (long long)json_integer_value(value));
+            break;
+        case JSON_REAL:
+            editor_json_writer_real(writer, json_real_value(value));
+            break;
+        case JSON_TRUE:
+            editor_json_writer_boolean(writer, true);
+            break;
+        case JSON_FALSE:
+            editor_json_writer_boolean(writer, false);
+            break;
+        default:
+            editor_json_writer_null(writer);
+    }
+}
+
+bool editor_json_writer_finish(struct editor_json_writer *writer){
+    editor_json_writer_flush(writer);
+    bool ok = !writer->failed && writer->depth == writer->base_depth;
+
+    free(writer->buf);
+    writer->buf = NULL;
+    writer->len = writer->cap = 0;
+    return ok;
+}
+
+char * editor_json_writer_take(struct editor_json_writer *writer, size_t *len){
+    char *text = NULL;
+    if(!writer->failed && writer->depth == writer->base_depth && writer->buf){
+        writer->buf[writer->len] = '\0';
+        text = writer->buf;
+        *len = writer->len;
+    }
+    else{
+        free(writer->buf);
+    }
+
+    writer->buf = NULL;
+    writer->len = writer->cap = 0;
+    return text;
+}
@@ -0,0 +1,117 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_log.h"
+
+void editor_log_ring_init(struct editor_log_ring *ring, int capacity){
+    ring->mutex = SDL_CreateMutex();
+    ring->lines = calloc(capacity, sizeof(struct editor_log_line));
+    ring->capacity = ring->lines ? capacity : 0;
+    ring->head = 0;
+    ring->count = 0;
+    ring->partial_len = 0;
+}
+
+void editor_log_ring_destroy(struct editor_log_ring *ring){
+    free(ring->lines);
+    ring->lines = NULL;
+    ring->capacity = 0;
+    ring->count = 0;
+    SDL_DestroyMutex(ring->mutex);
+    ring->mutex = NULL;
+}
+
+void editor_log_ring_clear(struct editor_log_ring *ring){
+    SDL_LockMutex(ring->mutex);
+    ring->head = 0;
+    ring->count = 0;
+    ring->partial_len = 0;
+    SDL_UnlockMutex(ring->mutex);
+}
+
+// expects the lock to be held
+static void _editor_log_ring_store(struct editor_log_ring *ring, const char *line, enum editor_log_kind kind){
+    if(ring->capacity == 0)
+        return;
+
+    int slot;
+    if(ring->count < ring->capacity){
+        slot = (ring->head + ring->count) % ring->capacity;
+        ring->count++;
+    }
+    else{
+        // full, overwrite the oldest
+        slot = ring->head;
+        ring->head = (ring->head + 1) % ring->capacity;
+    }
+
+    ring->lines[slot].kind = kind;
+    snprintf(ring->lines[slot].text, sizeof(ring->lines[slot].text), "%s", line);
+}
+
+void editor_log_ring_push(struct editor_log_ring *ring, const char *line, enum editor_log_kind kind){
+    SDL_LockMutex(ring->mutex);
+    _editor_log_ring_store(ring, line, kind);
+    SDL_UnlockMutex(ring->mutex);
+}
+
+// expects the lock to be held, terminates and stores the partial line
+static void _editor_log_ring_complete_partial(struct editor_log_ring *ring, editor_log_line_cb cb, void *userdata){
+    ring->partial[ring->partial_len] = '\0';
+
+    // strip \r from windows line endings
+    if(ring->partial_len > 0 && ring->partial[ring->partial_len - 1] == '\r')
+        ring->partial[--ring->partial_len] = '\0';
+
+    enum editor_log_kind kind = cb ? cb(ring->partial, userdata) : EDITOR_LOG_NORMAL;
+    _editor_log_ring_store(ring, ring->partial, kind);
+    ring->partial_len = 0;
+}
+
+void editor_log_ring_write(struct editor_log_ring *ring, const char *data, size_t len, editor_log_line_cb cb, void *userdata){
+    SDL_LockMutex(ring->mutex);
+    for(size_t i = 0; i < len; i++){
+        if(data[i] == '\n'){
+            _editor_log_ring_complete_partial(ring, cb, userdata);
+            continue;
+        }
+
+        // overlong lines get split rather than dropped
+        if(ring->partial_len >= sizeof(ring->partial) - 1)
+            _editor_log_ring_complete_partial(ring, cb, userdata);
+
+        ring->partial[ring->partial_len++] = data[i];
+    }
+    SDL_UnlockMutex(ring->mutex);
+}
+
+void editor_log_ring_flush(struct editor_log_ring *ring, editor_log_line_cb cb, void *userdata){
+    SDL_LockMutex(ring->mutex);
+    if(ring->partial_len > 0)
+        _editor_log_ring_complete_partial(ring, cb, userdata);
+    SDL_UnlockMutex(ring->mutex);
+}
+
+void editor_log_ring_lock(struct editor_log_ring *ring){
+    SDL_LockMutex(ring->mutex);
+}
+
+void editor_log_ring_unlock(struct editor_log_ring *ring){
+    SDL_UnlockMutex(ring->mutex);
+}
+
+const struct editor_log_line * editor_log_ring_line(struct editor_log_ring *ring, int i){
+    if(i < 0 || i >= ring->count)
+        return NULL;
+    return &ring->lines[(ring->head + i) % ring->capacity];
+}
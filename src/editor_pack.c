@@ -0,0 +1,473 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_build.h"
+#include "editor_pack.h"
+#include "editor_scene_binary.h"
+#include "editor_utils.h"
+
+struct editor_pack_job editor_pack_jobs[EDITOR_PACK_NUM_JOBS];
+
+/*
+    Manifest
+
+    Every pack keeps a json manifest of what went into it (relative path,
+    size, mtime and a content hash per file). A file is only re-hashed when
+    its size or mtime moved, and the pack is skipped when the new manifest
+    matches the stored one.
+*/
+
+struct editor_pack_entry {
+    char *path; // relative to the pack source
+    Sint64 size;
+    Sint64 mtime;
+    Uint64 hash;
+};
+
+struct editor_pack_scan {
+    size_t root_len;
+    struct editor_pack_entry *entries;
+    int count;
+    int capacity;
+};
+
+static bool editor_pack_hash_file(const char *path, Uint64 *out){
+    SDL_IOStream *io = SDL_IOFromFile(path, "rb");
+    if(!io)
+        return false;
+
+    Uint64 hash = EDITOR_HASH_SEED;
+    char buf[65536];
+    size_t read;
+    while((read = SDL_ReadIO(io, buf, sizeof(buf))) > 0)
+        hash = editor_hash(hash, buf, read);
+    SDL_CloseIO(io);
+
+    *out = hash;
+    return true;
+}
+
+static bool editor_pack_has_suffix(const char *name, const char *suffix){
+    size_t len = strlen(name), suffix_len = strlen(suffix);
+    return len > suffix_len && strcmp(name + len - suffix_len, suffix) == 0;
+}
+
+static SDL_EnumerationResult SDLCALL editor_pack_scan_cb(void *userdata, const char *dirname, const char *fname){
+    struct editor_pack_scan *scan = (struct editor_pack_scan *)userdata;
+
+    char full[1024];
+    snprintf(full, sizeof(full), "%s%s", dirname, fname);
+
+    SDL_PathInfo info;
+    if(!SDL_GetPathInfo(full, &info))
+        return SDL_ENUM_CONTINUE;
+
+    if(info.type == SDL_PATHTYPE_DIRECTORY){
+        strncat(full, "/", sizeof(full) - strlen(full) - 1);
+        SDL_EnumerateDirectory(full, editor_pack_scan_cb, scan);
+        return SDL_ENUM_CONTINUE;
+    }
+    if(info.type != SDL_PATHTYPE_FILE)
+        return SDL_ENUM_CONTINUE;
+
+    // half written files of a save in progress (see editor_serialize.c)
+    if(editor_pack_has_suffix(fname, ".tmp"))
+        return SDL_ENUM_CONTINUE;
+
+    // binary scene copies are an editor side experiment, the engine cannot load them yet
+    if(editor_pack_has_suffix(fname, EDITOR_SCENE_BINARY_EXTENSION))
+        return SDL_ENUM_CONTINUE;
+
+    if(scan->count == scan->capacity){
+        int capacity = scan->capacity ? scan->capacity * 2 : 256;
+        struct editor_pack_entry *grown = realloc(scan->entries, capacity * sizeof(struct editor_pack_entry));
+        if(!grown)
+            return SDL_ENUM_FAILURE;
+        scan->entries = grown;
+        scan->capacity = capacity;
+    }
+
+    struct editor_pack_entry *entry = &scan->entries[scan->count++];
+    entry->path = strdup(full + scan->root_len);
+    entry->size = (Sint64)info.size;
+    entry->mtime = (Sint64)info.modify_time;
+    entry->hash = 0;
+    return SDL_ENUM_CONTINUE;
+}
+
+static int editor_pack_entry_cmp(const void *a, const void *b){
+    return strcmp(((const struct editor_pack_entry *)a)->path, ((const struct editor_pack_entry *)b)->path);
+}
+
+/*
+    Scans the job's source directory and builds a fresh manifest, reusing
+    hashes from the old one for files whose size and mtime are unchanged.
+*/
+static json_t * editor_pack_build_manifest(struct editor_pack_job *job, json_t *old_manifest){
+    char root[1024];
+    snprintf(root, sizeof(root), "%s", job->source);
+    size_t len = strlen(root);
+    if(len > 0 && root[len - 1] != '/' && root[len - 1] != '\\')
+        strncat(root, "/", sizeof(root) - len - 1);
+
+    struct editor_pack_scan scan = {0};
+    scan.root_len = strlen(root);
+    SDL_EnumerateDirectory(root, editor_pack_scan_cb, &scan);
+
+    // sorted so the digest does not depend on directory iteration order
+    if(scan.count > 0)
+        qsort(scan.entries, scan.count, sizeof(struct editor_pack_entry), editor_pack_entry_cmp);
+
+    json_t *old_files = old_manifest ? json_object_get(old_manifest, "files") : NULL;
+    json_t *files = json_object();
+    Uint64 digest = EDITOR_HASH_SEED;
+
+    for(int i = 0; i < scan.count; i++){
+        struct editor_pack_entry *entry = &scan.entries[i];
+
+        json_t *old = old_files ? json_object_get(old_files, entry->path) : NULL;
+        const char *old_hash = old ? json_string_value(json_object_get(old, "hash")) : NULL;
+        if(old_hash &&
+           json_integer_value(json_object_get(old, "size")) == entry->size &&
+           json_integer_value(json_object_get(old, "mtime")) == entry->mtime){
+            entry->hash = strtoull(old_hash, NULL, 16);
+        }
+        else{
+            char full[1024];
+            snprintf(full, sizeof(full), "%s%s", root, entry->path);
+            editor_pack_hash_file(full, &entry->hash);
+            job->files_hashed++;
+        }
+
+        char hash_str[17];
+        snprintf(hash_str, sizeof(hash_str), "%016llx", (unsigned long long)entry->hash);
+
+        json_t *file = json_object();
+        json_object_set_new(file, "size", json_integer(entry->size));
+        json_object_set_new(file, "mtime", json_integer(entry->mtime));
+        json_object_set_new(file, "hash", json_string(hash_str));
+        json_object_set_new(files, entry->path, file);
+
+        digest = editor_hash(digest, entry->path, strlen(entry->path) + 1);
+        digest = editor_hash(digest, &entry->hash, sizeof(entry->hash));
+
+        free(entry->path);
+    }
+    job->files_total = scan.count;
+    free(scan.entries);
+
+    char digest_str[17];
+    snprintf(digest_str, sizeof(digest_str), "%016llx", (unsigned long long)digest);
+
+    json_t *manifest = json_object();
+    json_object_set_new(manifest, "version", json_integer(EDITOR_PACK_MANIFEST_VERSION));
+    json_object_set_new(manifest, "digest", json_string(digest_str));
+    json_object_set_new(manifest, "files", files);
+    return manifest;
+}
+
+/*
+    Pack cache
+
+    Packs are stored as <cache_dir>/<name>-<digest> next to a .hash file
+    holding the content hash of the pack itself. The hash is checked every
+    time the pack is handed out, a damaged or partially written cache entry
+    is dropped and rebuilt.
+*/
+static void editor_pack_cache_paths(struct editor_pack_job *job, const char *digest, char *pack, char *hash, size_t size){
+    snprintf(pack, size, "%s/%s-%s", job->cache_dir, job->name, digest);
+    snprintf(hash, size, "%s/%s-%s.hash", job->cache_dir, job->name, digest);
+}
+
+static bool editor_pack_cache_fetch(struct editor_pack_job *job, const char *digest){
+    char pack[1200], hash_path[1200];
+    editor_pack_cache_paths(job, digest, pack, hash_path, sizeof(pack));
+
+    size_t len = 0;
+    char *expected = SDL_LoadFile(hash_path, &len);
+    if(!expected)
+        return false;
+
+    Uint64 hash = 0;
+    char actual[17];
+    bool valid = editor_pack_hash_file(pack, &hash);
+    snprintf(actual, sizeof(actual), "%016llx", (unsigned long long)hash);
+    valid = valid && len >= 16 && strncmp(expected, actual, 16) == 0;
+    SDL_free(expected);
+
+    if(!valid){
+        SDL_RemovePath(pack);
+        SDL_RemovePath(hash_path);
+        return false;
+    }
+
+    // never write through an old hard link into the cache
+    SDL_RemovePath(job->output);
+    return editor_link_or_copy(pack, job->output);
+}
+
+static void editor_pack_cache_store(struct editor_pack_job *job, const char *digest){
+    char pack[1200], hash_path[1200];
+    editor_pack_cache_paths(job, digest, pack, hash_path, sizeof(pack));
+
+    Uint64 hash = 0;
+    if(!editor_pack_hash_file(job->output, &hash))
+        return;
+
+    // staged and renamed, another project may be reading the cache right now
+    char staging[1300];
+    snprintf(staging, sizeof(staging), "%s.%llx", pack, (unsigned long long)SDL_GetTicksNS());
+    if(!SDL_CopyFile(job->output, staging) || !SDL_RenamePath(staging, pack)){
+        SDL_RemovePath(staging);
+        return;
+    }
+
+    char hash_str[17];
+    snprintf(hash_str, sizeof(hash_str), "%016llx", (unsigned long long)hash);
+    SDL_SaveFile(hash_path, hash_str, strlen(hash_str));
+}
+
+static void editor_pack_run(struct editor_pack_job *job){
+    json_t *old_manifest = json_load_file(job->manifest, 0, NULL);
+    if(old_manifest && json_integer_value(json_object_get(old_manifest, "version")) != EDITOR_PACK_MANIFEST_VERSION){
+        json_decref(old_manifest);
+        old_manifest = NULL;
+    }
+
+    job->files_total = 0;
+    job->files_hashed = 0;
+    json_t *manifest = editor_pack_build_manifest(job, old_manifest);
+
+    const char *old_digest = old_manifest ? json_string_value(json_object_get(old_manifest, "digest")) : NULL;
+    const char *new_digest = json_string_value(json_object_get(manifest, "digest"));
+    job->skipped = !job->force && old_digest && strcmp(old_digest, new_digest) == 0 && SDL_GetPathInfo(job->output, NULL);
+
+    if(!job->skipped){
+        // a forced pack is a request to rebuild from source, the result still refreshes the cache
+        job->from_cache = !job->force && job->cache_dir[0] && editor_pack_cache_fetch(job, new_digest);
+        if(!job->from_cache){
+            /*
+                yep can only write a whole pack, so any change means a full repack.
+                Forced, because the manifest already decided something is different.
+                The old file is removed first in case it is a hard link into the cache
+            */
+            SDL_RemovePath(job->output);
+            yep_force_pack_directory(job->source, job->output);
+            if(job->cache_dir[0])
+                editor_pack_cache_store(job, new_digest);
+        }
+        json_dump_file(manifest, job->manifest, JSON_INDENT(4));
+    }
+
+    json_decref(manifest);
+    if(old_manifest)
+        json_decref(old_manifest);
+
+    job->end_ticks = SDL_GetTicks();
+
+    char line[EDITOR_LOG_LINE_MAX];
+    if(job->skipped)
+        snprintf(line, sizeof(line), "%s is up to date (%d files, checked in %.2fs)", job->name, job->files_total, (job->end_ticks - job->start_ticks) / 1000.0f);
+    else if(job->from_cache)
+        snprintf(line, sizeof(line), "Reused %s from the editor cache in %.2fs", job->name, (job->end_ticks - job->start_ticks) / 1000.0f);
+    else
+        snprintf(line, sizeof(line), "Packed %s in %.2fs (%d files, %d rehashed)", job->name, (job->end_ticks - job->start_ticks) / 1000.0f, job->files_total, job->files_hashed);
+    editor_log_ring_push(job->log, line, EDITOR_LOG_NORMAL);
+}
+
+// copies a request into the job, the engine path helpers return static buffers
+static void editor_pack_set_request(struct editor_pack_job *job, const struct editor_pack_request *request){
+    snprintf(job->name, sizeof(job->name), "%s", request->name);
+    snprintf(job->source, sizeof(job->source), "%s", request->source);
+    snprintf(job->output, sizeof(job->output), "%s", request->output);
+    snprintf(job->manifest, sizeof(job->manifest), "%s", request->manifest);
+    snprintf(job->cache_dir, sizeof(job->cache_dir), "%s", request->cache_dir);
+    job->force = request->force;
+    job->log = request->log;
+    job->skipped = false;
+    job->from_cache = false;
+    job->start_ticks = SDL_GetTicks();
+    job->end_ticks = 0;
+}
+
+/*
+    A request queued while the job ran is picked up here before the job
+    reports done, so anyone waiting on it also waits for the follow-up
+*/
+static int editor_pack_thread(void *data){
+    struct editor_pack_job *job = (struct editor_pack_job *)data;
+
+    for(;;){
+        editor_pack_run(job);
+
+        SDL_LockSpinlock(&job->pending_lock);
+        bool again = job->has_pending;
+        if(again){
+            editor_pack_set_request(job, &job->pending);
+            job->has_pending = false;
+        }
+        else{
+            SDL_SetAtomicInt(&job->state, EDITOR_PACK_DONE);
+        }
+        SDL_UnlockSpinlock(&job->pending_lock);
+
+        if(!again)
+            return 0;
+    }
+}
+
+static void editor_pack_reap(struct editor_pack_job *job){
+    SDL_WaitThread(job->thread, NULL);
+    job->thread = NULL;
+    SDL_SetAtomicInt(&job->state, EDITOR_PACK_IDLE);
+
+    if(job->skipped)
+        ye_logf(debug, "%s is up to date, skipped packing.\n", job->name);
+    else if(job->from_cache)
+        ye_logf(info, "Reused %s from the editor cache.\n", job->name);
+    else
+        ye_logf(info, "Packed %s in %.2fs.\n", job->name, (job->end_ticks - job->start_ticks) / 1000.0f);
+}
+
+static void editor_pack_launch(struct editor_pack_job *job, const char *name, const char *source, const char *output, const char *manifest, const char *cache_dir, bool force, struct editor_log_ring *log){
+    // a job still waiting to be reaped from last time
+    if(job->thread && SDL_GetAtomicInt(&job->state) == EDITOR_PACK_DONE)
+        editor_pack_reap(job);
+
+    struct editor_pack_request request;
+    snprintf(request.name, sizeof(request.name), "%s", name);
+    snprintf(request.source, sizeof(request.source), "%s", source);
+    snprintf(request.output, sizeof(request.output), "%s", output);
+    snprintf(request.manifest, sizeof(request.manifest), "%s", manifest);
+    snprintf(request.cache_dir, sizeof(request.cache_dir), "%s", cache_dir ? cache_dir : "");
+    request.force = force;
+    request.log = log;
+
+    /*
+        A running pack of the same output already covers a plain request.
+        Anything more (a forced repack, a different output) is queued and
+        runs once the current pack is through, a second forced request
+        folds into the queued one.
+    */
+    SDL_LockSpinlock(&job->pending_lock);
+    if(SDL_GetAtomicInt(&job->state) == EDITOR_PACK_RUNNING){
+        if(job->has_pending && strcmp(job->pending.output, request.output) == 0)
+            request.force = request.force || job->pending.force;
+
+        if(!job->has_pending && (!force || job->force) && strcmp(job->output, request.output) == 0){
+            ye_logf(debug, "%s is already being packed.\n", name);
+        }
+        else{
+            job->pending = request;
+            job->has_pending = true;
+            ye_logf(debug, "%s is being packed, queued another %spack.\n", name, request.force ? "forced " : "");
+        }
+        SDL_UnlockSpinlock(&job->pending_lock);
+        return;
+    }
+    SDL_UnlockSpinlock(&job->pending_lock);
+
+    editor_pack_set_request(job, &request);
+
+    SDL_SetAtomicInt(&job->state, EDITOR_PACK_RUNNING);
+    job->thread = SDL_CreateThread(editor_pack_thread, "PackThread", job);
+    if(job->thread == NULL){
+        ye_logf(error, "Failed to create pack thread for %s: %s\n", name, SDL_GetError());
+        SDL_SetAtomicInt(&job->state, EDITOR_PACK_IDLE);
+    }
+}
+
+// ye_path() for the open project, project_root/subpath for any other
+static const char * editor_pack_project_path(const char *project_root, const char *subpath){
+    if(!project_root)
+        return ye_path(subpath);
+
+    static char path[1024];
+    snprintf(path, sizeof(path), "%s/%s", project_root, subpath);
+    return path;
+}
+
+static void editor_pack_start_jobs(struct editor_pack_job *jobs, const char *project_root, bool force, struct editor_log_ring *log){
+    // manifests live in the build dir, which is ignored by the project template
+    ye_mkdir(editor_pack_project_path(project_root, "build"));
+
+    // ye_path() reuses one static buffer, every path needs its own copy
+    char source[1024], output[1024], manifest[1024], cache_dir[1024];
+
+    // shared by every project, if the install dir is read only each project packs its own
+    snprintf(cache_dir, sizeof(cache_dir), "%s", editor_path("pack_cache"));
+    if(!SDL_CreateDirectory(cache_dir))
+        cache_dir[0] = '\0';
+
+    snprintf(source, sizeof(source), "%s", ye_get_engine_resource_static(""));
+    snprintf(output, sizeof(output), "%s", editor_pack_project_path(project_root, "engine.yep"));
+    snprintf(manifest, sizeof(manifest), "%s", editor_pack_project_path(project_root, "build/engine.yep.manifest"));
+    editor_pack_launch(&jobs[0], "engine.yep", source, output, manifest, cache_dir, force, log);
+
+    snprintf(source, sizeof(source), "%s", editor_pack_project_path(project_root, "resources/"));
+    snprintf(output, sizeof(output), "%s", editor_pack_project_path(project_root, "resources.yep"));
+    snprintf(manifest, sizeof(manifest), "%s", editor_pack_project_path(project_root, "build/resources.yep.manifest"));
+    editor_pack_launch(&jobs[1], "resources.yep", source, output, manifest, NULL, force, log);
+}
+
+void editor_pack_start(bool force){
+    editor_pack_start_jobs(editor_pack_jobs, NULL, force, &editor_build_log);
+}
+
+void editor_pack_start_project(struct editor_pack_job *jobs, const char *project_root, bool force, struct editor_log_ring *log){
+    editor_pack_start_jobs(jobs, project_root, force, log);
+}
+
+bool editor_pack_jobs_poll(struct editor_pack_job *jobs){
+    bool idle = true;
+    for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+        struct editor_pack_job *job = &jobs[i];
+        if(job->thread && SDL_GetAtomicInt(&job->state) == EDITOR_PACK_DONE)
+            editor_pack_reap(job);
+        if(SDL_GetAtomicInt(&job->state) == EDITOR_PACK_RUNNING)
+            idle = false;
+    }
+    return idle;
+}
+
+void editor_pack_poll(){
+    for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+        struct editor_pack_job *job = &editor_pack_jobs[i];
+        if(job->thread && SDL_GetAtomicInt(&job->state) == EDITOR_PACK_DONE)
+            editor_pack_reap(job);
+    }
+}
+
+void editor_pack_wait(){
+    for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+        struct editor_pack_job *job = &editor_pack_jobs[i];
+        if(job->thread)
+            editor_pack_reap(job);
+    }
+}
+
+void editor_pack_await(){
+    while(editor_pack_is_running())
+        SDL_Delay(20);
+}
+
+bool editor_pack_is_running(){
+    for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+        if(SDL_GetAtomicInt(&editor_pack_jobs[i].state) == EDITOR_PACK_RUNNING)
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,504 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_build.h"
+#include "editor_game.h"
+#include "editor_panels.h"
+#include "editor_profile.h"
+
+struct editor_profile_state editor_profile;
+
+static SDL_Mutex *profile_mutex = NULL;
+
+// owned by the main thread
+static SDL_Thread *profile_thread = NULL;
+static SDL_AtomicInt profile_finished;
+
+// game launched from a profiling build whose exit we are waiting for
+static bool profile_expecting = false;
+static char profile_expected_exe[1024];
+static char profile_expected_gmon[1100];
+
+// handed to the worker
+static char profile_exe[1024];
+static char profile_gmon[1100];
+
+void editor_profile_lock(){
+    SDL_LockMutex(profile_mutex);
+}
+
+void editor_profile_unlock(){
+    SDL_UnlockMutex(profile_mutex);
+}
+
+static void profile_set_status(int status, const char *msg){
+    editor_profile_lock();
+    editor_profile.status = status;
+    snprintf(editor_profile.status_msg, sizeof(editor_profile.status_msg), "%s", msg);
+    editor_profile_unlock();
+}
+
+/*
+    gprof output parsing
+*/
+
+struct profile_result {
+    struct editor_profile_function *functions;
+    int num_functions;
+    int cap_functions;
+
+    struct editor_profile_arc *arcs;
+    int num_arcs;
+    int cap_arcs;
+
+    float sampled_seconds;
+    double per_call_to_ms;  // the flat profile's per call columns use whatever unit gprof picked
+};
+
+static bool profile_grow(void **array, int *cap, int count, size_t elem){
+    if(count < *cap)
+        return true;
+    int new_cap = *cap ? *cap * 2 : 256;
+    void *grown = realloc(*array, new_cap * elem);
+    if(!grown)
+        return false;
+    *array = grown;
+    *cap = new_cap;
+    return true;
+}
+
+// reads up to max leading numbers off line, returns how many and where the rest starts
+static int profile_read_numbers(const char *line, double *out, int max, const char **rest){
+    int count = 0;
+    const char *p = line;
+    while(count < max){
+        while(*p == ' ' || *p == '\t')
+            p++;
+        // names never start with a digit, so the first non number is the name
+        if(!SDL_isdigit((unsigned char)*p) && *p != '.')
+            break;
+        char *end;
+        out[count++] = SDL_strtod(p, &end);
+        if(end == p)
+            break;
+        p = end;
+    }
+    while(*p == ' ' || *p == '\t')
+        p++;
+    *rest = p;
+    return count;
+}
+
+// copies a name, dropping a trailing " [N]" call graph reference and whitespace
+static void profile_copy_name(char *out, const char *name){
+    snprintf(out, EDITOR_PROFILE_NAME_MAX, "%s", name);
+    size_t len = strlen(out);
+    while(len > 0 && (out[len - 1] == ' ' || out[len - 1] == '\r'))
+        out[--len] = '\0';
+    if(len > 0 && out[len - 1] == ']'){
+        char *open = strrchr(out, '[');
+        if(open && open > out && open[-1] == ' '){
+            open[-1] = '\0';
+        }
+    }
+}
+
+/*
+    gprof scales the per call columns of the flat profile to fit and names
+    the unit in the header ("ms/call", "us/call", " s/call", "Ts/call"...),
+    returns the factor that turns them into milliseconds
+*/
+static double profile_per_call_unit(const char *header){
+    const char *call = strstr(header, "s/call");
+    if(!call || call == header)
+        return 1.0;
+
+    switch(call[-1]){
+        case 'T': return 1e15;
+        case 'G': return 1e12;
+        case 'M': return 1e9;
+        case 'K': return 1e6;
+        case ' ': return 1e3;
+        case 'm': return 1.0;
+        case 'u': return 1e-3;
+        case 'n': return 1e-6;
+        case 'p': return 1e-9;
+        case 'f': return 1e-12;
+        case 'a': return 1e-15;
+        default:  return 1.0;
+    }
+}
+
+/*
+      %   cumulative   self              self     total
+     time   seconds   seconds    calls  ms/call  ms/call  name
+     33.34      0.02     0.02     7208     0.00     0.00  open
+     16.67      0.03     0.01                             frame_dummy
+
+    (the call columns are blank for functions that were not compiled with -pg)
+*/
+static void profile_parse_flat_line(struct profile_result *result, const char *line){
+    double numbers[6];
+    const char *name;
+    int count = profile_read_numbers(line, numbers, 6, &name);
+    if((count != 3 && count != 6) || *name == '\0')
+        return;
+    if(!profile_grow((void **)&result->functions, &result->cap_functions, result->num_functions, sizeof(struct editor_profile_function)))
+        return;
+
+    struct editor_profile_function *function = &result->functions[result->num_functions++];
+    memset(function, 0, sizeof(*function));
+    profile_copy_name(function->name, name);
+    function->index = -1;
+    function->percent = (float)numbers[0];
+    function->self_seconds = (float)numbers[2];
+    function->total_seconds = function->self_seconds;
+    function->calls = -1;
+    if(count == 6){
+        function->calls = (long)numbers[3];
+        function->self_ms_per_call = (float)(numbers[4] * result->per_call_to_ms);
+        function->total_ms_per_call = (float)(numbers[5] * result->per_call_to_ms);
+    }
+    if(numbers[1] > result->sampled_seconds)
+        result->sampled_seconds = (float)numbers[1];
+}
+
+/*
+                    0.01    0.01       1/1           main [2]
+    [1]    100.0    0.01    0.01       1         foo [1]
+                    0.01    0.00       1/1           bar [3]
+    -----------------------------------------------
+
+    Lines above the [N] line are the callers of N, lines below it its callees
+*/
+static void profile_parse_graph_line(struct profile_result *result, const char *line, int *owner, bool *seen_primary){
+    const char *p = line;
+    while(*p == ' ' || *p == '\t')
+        p++;
+
+    if(*p == '['){
+        int index = atoi(p + 1);
+        const char *close = strchr(p, ']');
+        if(!close)
+            return;
+
+        double numbers[3];
+        const char *rest;
+        int count = profile_read_numbers(close + 1, numbers, 3, &rest);
+        if(count < 3)
+            return;
+
+        // the called column, "5" or "5+2" for recursive functions
+        while(SDL_isdigit((unsigned char)*rest) || *rest == '+')
+            rest++;
+        while(*rest == ' ' || *rest == '\t')
+            rest++;
+
+        char name[EDITOR_PROFILE_NAME_MAX];
+        profile_copy_name(name, rest);
+
+        // the flat profile came first, hook the totals onto it
+        for(int i = 0; i < result->num_functions; i++){
+            struct editor_profile_function *function = &result->functions[i];
+            if(function->index == -1 && strcmp(function->name, name) == 0){
+                function->index = index;
+                function->total_seconds = (float)(numbers[1] + numbers[2]);
+                break;
+            }
+        }
+
+        *owner = index;
+        *seen_primary = true;
+        return;
+    }
+
+    // "<spontaneous>" and other lines without times
+    double numbers[2];
+    const char *rest;
+    if(profile_read_numbers(p, numbers, 2, &rest) < 2)
+        return;
+
+    if(!profile_grow((void **)&result->arcs, &result->cap_arcs, result->num_arcs, sizeof(struct editor_profile_arc)))
+        return;
+
+    struct editor_profile_arc *arc = &result->arcs[result->num_arcs];
+    memset(arc, 0, sizeof(*arc));
+    arc->self_seconds = (float)numbers[0];
+    arc->child_seconds = (float)numbers[1];
+
+    size_t calls_len = 0;
+    while((SDL_isdigit((unsigned char)rest[calls_len]) || rest[calls_len] == '/' || rest[calls_len] == '+') && calls_len < sizeof(arc->calls) - 1)
+        calls_len++;
+    memcpy(arc->calls, rest, calls_len);
+    arc->calls[calls_len] = '\0';
+    rest += calls_len;
+    while(*rest == ' ' || *rest == '\t')
+        rest++;
+
+    profile_copy_name(arc->name, rest);
+    arc->is_caller = !*seen_primary;
+    // callers are only known to belong to the entry once its [N] line shows up
+    arc->owner = *seen_primary ? *owner : -1;
+    result->num_arcs++;
+}
+
+static void profile_parse(struct profile_result *result, char *output){
+    enum { SECTION_NONE, SECTION_FLAT, SECTION_GRAPH } section = SECTION_NONE;
+    bool in_table = false;
+    int owner = -1;
+    bool seen_primary = false;
+    int block_start = 0;
+
+    char *save = NULL;
+    for(char *line = SDL_strtok_r(output, "\n", &save); line; line = SDL_strtok_r(NULL, "\n", &save)){
+        if(strncmp(line, "Flat profile:", 13) == 0){
+            section = SECTION_FLAT;
+            in_table = false;
+            continue;
+        }
+        if(strstr(line, "Call graph") && section != SECTION_GRAPH){
+            section = SECTION_GRAPH;
+            in_table = false;
+            continue;
+        }
+        if(strncmp(line, "Index by function name", 22) == 0)
+            break;
+
+        // the tables start after their column header line
+        if(!in_table){
+            if(section == SECTION_FLAT && strstr(line, "name") && strstr(line, "time")){
+                result->per_call_to_ms = profile_per_call_unit(line);
+                in_table = true;
+            }
+            if(section == SECTION_GRAPH && strncmp(line, "index", 5) == 0)
+                in_table = true;
+            continue;
+        }
+
+        if(section == SECTION_FLAT){
+            profile_parse_flat_line(result, line);
+        }
+        else if(section == SECTION_GRAPH){
+            if(strncmp(line, "-----", 5) == 0){
+                owner = -1;
+                seen_primary = false;
+                block_start = result->num_arcs;
+                continue;
+            }
+
+            bool was_primary = seen_primary;
+            profile_parse_graph_line(result, line, &owner, &seen_primary);
+
+            // the [N] line just showed up, hand it the callers listed above it
+            if(!was_primary && seen_primary){
+                for(int i = block_start; i < result->num_arcs; i++)
+                    result->arcs[i].owner = owner;
+            }
+        }
+    }
+}
+
+static int profile_thread_fn(void *data){
+    (void)data;
+
+    const char *args[] = { "gprof", "-b", profile_exe, profile_gmon, NULL };
+    SDL_PropertiesID props = SDL_CreateProperties();
+    SDL_SetPointerProperty(props, SDL_PROP_PROCESS_CREATE_ARGS_POINTER, (void *)args);
+    SDL_SetNumberProperty(props, SDL_PROP_PROCESS_CREATE_STDOUT_NUMBER, SDL_PROCESS_STDIO_APP);
+    SDL_SetBooleanProperty(props, SDL_PROP_PROCESS_CREATE_STDERR_TO_STDOUT_BOOLEAN, true);
+    SDL_Process *proc = SDL_CreateProcessWithProperties(props);
+    SDL_DestroyProperties(props);
+
+    if(!proc){
+        char msg[256];
+        snprintf(msg, sizeof(msg), "Could not run gprof (is binutils installed?): %s", SDL_GetError());
+        profile_set_status(3, msg);
+        SDL_SetAtomicInt(&profile_finished, 1);
+        return 0;
+    }
+
+    int exit_code = -1;
+    size_t size = 0;
+    char *output = SDL_ReadProcess(proc, &size, &exit_code);
+    SDL_DestroyProcess(proc);
+
+    if(!output || exit_code != 0){
+        char msg[256];
+        snprintf(msg, sizeof(msg), "gprof failed (exit code %d): %.200s", exit_code, output ? output : "no output");
+        profile_set_status(3, msg);
+        SDL_free(output);
+        SDL_SetAtomicInt(&profile_finished, 1);
+        return 0;
+    }
+
+    struct profile_result result = {0};
+    profile_parse(&result, output);
+    SDL_free(output);
+
+    char msg[256];
+    snprintf(msg, sizeof(msg), "%d functions, %.2fs sampled", result.num_functions, result.sampled_seconds);
+
+    editor_profile_lock();
+    free(editor_profile.functions);
+    free(editor_profile.arcs);
+    editor_profile.functions = result.functions;
+    editor_profile.num_functions = result.num_functions;
+    editor_profile.arcs = result.arcs;
+    editor_profile.num_arcs = result.num_arcs;
+    editor_profile.sampled_seconds = result.sampled_seconds;
+    editor_profile_unlock();
+
+    if(result.num_functions == 0)
+        profile_set_status(3, "The profile is empty, was the game compiled with -pg?");
+    else
+        profile_set_status(2, msg);
+
+    SDL_SetAtomicInt(&profile_finished, 1);
+    return 0;
+}
+
+void editor_profile_init(){
+    profile_mutex = SDL_CreateMutex();
+}
+
+void editor_profile_shutdown(){
+    if(profile_thread){
+        SDL_WaitThread(profile_thread, NULL);
+        profile_thread = NULL;
+    }
+    free(editor_profile.functions);
+    free(editor_profile.arcs);
+    memset(&editor_profile, 0, sizeof(editor_profile));
+    SDL_DestroyMutex(profile_mutex);
+    profile_mutex = NULL;
+}
+
+bool editor_profile_output_prefix(char *out, size_t size){
+    char build_dir[1024];
+    if(!editor_active_build_dir(build_dir, sizeof(build_dir)))
+        return false;
+    snprintf(out, size, "%s/gmon.out", build_dir);
+    return true;
+}
+
+void editor_profile_expect(const char *exe_path, Sint64 pid){
+    char prefix[1024];
+    if(!editor_profile_output_prefix(prefix, sizeof(prefix)))
+        return;
+
+    snprintf(profile_expected_exe, sizeof(profile_expected_exe), "%s", exe_path);
+    snprintf(profile_expected_gmon, sizeof(profile_expected_gmon), "%s.%lld", prefix, (long long)pid);
+    profile_expecting = true;
+}
+
+bool editor_profile_load(const char *exe_path, const char *gmon_path){
+    if(profile_thread){
+        ye_logf(warning, "A profile is already being analyzed.\n");
+        return false;
+    }
+
+    snprintf(profile_exe, sizeof(profile_exe), "%s", exe_path);
+    snprintf(profile_gmon, sizeof(profile_gmon), "%s", gmon_path);
+
+    editor_profile_lock();
+    snprintf(editor_profile.source, sizeof(editor_profile.source), "%s", gmon_path);
+    editor_profile_unlock();
+    profile_set_status(1, "Running gprof ...");
+
+    SDL_SetAtomicInt(&profile_finished, 0);
+    profile_thread = SDL_CreateThread(profile_thread_fn, "ProfileAnalysis", NULL);
+    if(profile_thread == NULL){
+        ye_logf(error, "Failed to create profile thread: %s\n", SDL_GetError());
+        profile_set_status(3, "Failed to start the analysis.");
+        return false;
+    }
+    return true;
+}
+
+void editor_profile_poll(){
+    if(profile_thread && SDL_GetAtomicInt(&profile_finished)){
+        SDL_WaitThread(profile_thread, NULL);
+        profile_thread = NULL;
+
+        editor_profile_lock();
+        editor_profile_sort(editor_profile.sort_key);
+        if(editor_profile.status == 3)
+            ye_logf(error, "Profile analysis failed: %s\n", editor_profile.status_msg);
+        editor_profile_unlock();
+    }
+
+    if(!profile_expecting)
+        return;
+
+    editor_game_lock();
+    bool running = editor_game.running;
+    editor_game_unlock();
+    if(running)
+        return;
+
+    profile_expecting = false;
+
+    // glibc only writes the profile from exit(), a killed or crashed game leaves none
+    if(!ye_file_exists(profile_expected_gmon)){
+        ye_logf(warning, "The game left no profile at %s, quit it normally to write one.\n", profile_expected_gmon);
+        return;
+    }
+
+    if(editor_profile_load(profile_expected_exe, profile_expected_gmon))
+        editor_panel_profile_open();
+}
+
+/*
+    Sorting, expects the lock to be held
+*/
+
+static enum editor_profile_sort_key profile_sort_key;
+
+static int profile_compare(const void *a, const void *b){
+    const struct editor_profile_function *fa = (const struct editor_profile_function *)a;
+    const struct editor_profile_function *fb = (const struct editor_profile_function *)b;
+
+    float va = 0, vb = 0;
+    switch(profile_sort_key){
+        case EDITOR_PROFILE_SORT_NAME:
+            return strcmp(fa->name, fb->name);
+        case EDITOR_PROFILE_SORT_SELF:
+            va = fa->self_seconds; vb = fb->self_seconds;
+            break;
+        case EDITOR_PROFILE_SORT_TOTAL:
+            va = fa->total_seconds; vb = fb->total_seconds;
+            break;
+        case EDITOR_PROFILE_SORT_CALLS:
+            va = (float)fa->calls; vb = (float)fb->calls;
+            break;
+        case EDITOR_PROFILE_SORT_SELF_PER_CALL:
+            va = fa->self_ms_per_call; vb = fb->self_ms_per_call;
+            break;
+        case EDITOR_PROFILE_SORT_TOTAL_PER_CALL:
+            va = fa->total_ms_per_call; vb = fb->total_ms_per_call;
+            break;
+    }
+    // descending, ties by name so the order is stable between sorts
+    if(va != vb)
+        return va < vb ? 1 : -1;
+    return strcmp(fa->name, fb->name);
+}
+
+void editor_profile_sort(enum editor_profile_sort_key key){
+    editor_profile.sort_key = key;
+    profile_sort_key = key;
+    if(editor_profile.num_functions > 1)
+        qsort(editor_profile.functions, editor_profile.num_functions, sizeof(struct editor_profile_function), profile_compare);
+}
@@ -0,0 +1,787 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_scene_binary.h"
+
+enum scene_binary_tag {
+    SCENE_BINARY_NULL,
+    SCENE_BINARY_FALSE,
+    SCENE_BINARY_TRUE,
+    SCENE_BINARY_INT,
+    SCENE_BINARY_F32,
+    SCENE_BINARY_F64,
+    SCENE_BINARY_STRING,
+    SCENE_BINARY_ARRAY,
+    SCENE_BINARY_OBJECT,
+};
+
+/*
+    Nothing in here logs, the save thread converts too. Failures are
+    described in the caller's error buffer (which may be NULL) instead.
+*/
+static void scene_binary_error(char *error, size_t size, const char *fmt, ...){
+    if(!error || size == 0)
+        return;
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(error, size, fmt, args);
+    va_end(args);
+}
+
+/*
+    Output buffer
+*/
+struct scene_binary_buffer {
+    Uint8 *data;
+    size_t len;
+    size_t cap;
+    bool failed;
+};
+
+static void scene_binary_put(struct scene_binary_buffer *buf, const void *data, size_t len){
+    if(buf->failed)
+        return;
+
+    if(buf->len + len > buf->cap){
+        size_t cap = buf->cap ? buf->cap : 4096;
+        while(cap < buf->len + len)
+            cap *= 2;
+        Uint8 *grown = realloc(buf->data, cap);
+        if(!grown){
+            buf->failed = true;
+            return;
+        }
+        buf->data = grown;
+        buf->cap = cap;
+    }
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+}
+
+static void scene_binary_put_u8(struct scene_binary_buffer *buf, Uint8 value){
+    scene_binary_put(buf, &value, 1);
+}
+
+static void scene_binary_put_le(struct scene_binary_buffer *buf, Uint64 value, int bytes){
+    Uint8 out[8];
+    for(int i = 0; i < bytes; i++)
+        out[i] = (Uint8)(value >> (8 * i));
+    scene_binary_put(buf, out, bytes);
+}
+
+static void scene_binary_put_varint(struct scene_binary_buffer *buf, Uint64 value){
+    Uint8 out[10];
+    int len = 0;
+    do{
+        Uint8 byte = value & 0x7F;
+        value >>= 7;
+        out[len++] = value ? (byte | 0x80) : byte;
+    } while(value);
+    scene_binary_put(buf, out, len);
+}
+
+/*
+    Encoder
+
+    A first pass over the document collects every string and every object
+    shape into open addressed tables (at most half full), the second pass
+    writes the tables and then the values, which only refer to them.
+*/
+struct scene_binary_string {
+    const char *text;
+    size_t len;
+};
+
+struct scene_binary_shape {
+    Uint32 *keys;   // string indices
+    Uint32 count;
+};
+
+struct scene_binary_encoder {
+    struct scene_binary_string *strings;
+    Uint32 num_strings;
+    Uint32 *string_slots;   // index + 1, 0 for an empty slot
+    size_t string_slots_cap;
+
+    struct scene_binary_shape *shapes;
+    Uint32 num_shapes;
+    Uint32 *shape_slots;
+    size_t shape_slots_cap;
+
+    bool failed;
+};
+
+static Uint64 scene_binary_hash(const void *data, size_t len){
+    // FNV-1a
+    const Uint8 *bytes = data;
+    Uint64 hash = 0xcbf29ce484222325ull;
+    for(size_t i = 0; i < len; i++){
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static Uint64 scene_binary_string_hash(const struct scene_binary_string *str){
+    return scene_binary_hash(str->text, str->len);
+}
+
+static Uint64 scene_binary_shape_hash(const struct scene_binary_shape *shape){
+    return scene_binary_hash(shape->keys, shape->count * sizeof(Uint32));
+}
+
+// doubles a slot table (it is rebuilt from the entries), false when out of memory
+static bool scene_binary_grow_slots(struct scene_binary_encoder *enc, bool shapes){
+    size_t cap = shapes ? enc->shape_slots_cap : enc->string_slots_cap;
+    cap = cap ? cap * 2 : 256;
+
+    Uint32 *slots = calloc(cap, sizeof(Uint32));
+    if(!slots)
+        return false;
+
+    Uint32 count = shapes ? enc->num_shapes : enc->num_strings;
+    for(Uint32 i = 0; i < count; i++){
+        Uint64 hash = shapes ? scene_binary_shape_hash(&enc->shapes[i]) : scene_binary_string_hash(&enc->strings[i]);
+        size_t slot = (size_t)hash & (cap - 1);
+        while(slots[slot])
+            slot = (slot + 1) & (cap - 1);
+        slots[slot] = i + 1;
+    }
+
+    if(shapes){
+        free(enc->shape_slots);
+        enc->shape_slots = slots;
+        enc->shape_slots_cap = cap;
+    }
+    else{
+        free(enc->string_slots);
+        enc->string_slots = slots;
+        enc->string_slots_cap = cap;
+    }
+    return true;
+}
+
+static Uint32 scene_binary_intern_string(struct scene_binary_encoder *enc, const char *text, size_t len){
+    if(enc->failed)
+        return 0;
+
+    if((enc->num_strings + 1) * 2 > enc->string_slots_cap){
+        struct scene_binary_string *grown = realloc(enc->strings, (enc->string_slots_cap ? enc->string_slots_cap : 256) * sizeof(struct scene_binary_string));
+        if(grown)
+            enc->strings = grown;
+        if(!grown || !scene_binary_grow_slots(enc, false)){
+            enc->failed = true;
+            return 0;
+        }
+    }
+
+    struct scene_binary_string str = {text, len};
+    size_t slot = (size_t)scene_binary_string_hash(&str) & (enc->string_slots_cap - 1);
+    while(enc->string_slots[slot]){
+        struct scene_binary_string *existing = &enc->strings[enc->string_slots[slot] - 1];
+        if(existing->len == len && memcmp(existing->text, text, len) == 0)
+            return enc->string_slots[slot] - 1;
+        slot = (slot + 1) & (enc->string_slots_cap - 1);
+    }
+
+    enc->strings[enc->num_strings] = str;
+    enc->string_slots[slot] = ++enc->num_strings;
+    return enc->num_strings - 1;
+}
+
+// takes ownership of keys
+static Uint32 scene_binary_intern_shape(struct scene_binary_encoder *enc, Uint32 *keys, Uint32 count){
+    if(enc->failed){
+        free(keys);
+        return 0;
+    }
+
+    if((enc->num_shapes + 1) * 2 > enc->shape_slots_cap){
+        struct scene_binary_shape *grown = realloc(enc->shapes, (enc->shape_slots_cap ? enc->shape_slots_cap : 256) * sizeof(struct scene_binary_shape));
+        if(grown)
+            enc->shapes = grown;
+        if(!grown || !scene_binary_grow_slots(enc, true)){
+            enc->failed = true;
+            free(keys);
+            return 0;
+        }
+    }
+
+    struct scene_binary_shape shape = {keys, count};
+    size_t slot = (size_t)scene_binary_shape_hash(&shape) & (enc->shape_slots_cap - 1);
+    while(enc->shape_slots[slot]){
+        struct scene_binary_shape *existing = &enc->shapes[enc->shape_slots[slot] - 1];
+        if(existing->count == count && memcmp(existing->keys, keys, count * sizeof(Uint32)) == 0){
+            free(keys);
+            return enc->shape_slots[slot] - 1;
+        }
+        slot = (slot + 1) & (enc->shape_slots_cap - 1);
+    }
+
+    enc->shapes[enc->num_shapes] = shape;
+    enc->shape_slots[slot] = ++enc->num_shapes;
+    return enc->num_shapes - 1;
+}
+
+static Uint32 scene_binary_object_shape(struct scene_binary_encoder *enc, json_t *object){
+    Uint32 count = (Uint32)json_object_size(object);
+    Uint32 *keys = malloc((count ? count : 1) * sizeof(Uint32));
+    if(!keys){
+        enc->failed = true;
+        return 0;
+    }
+
+    Uint32 i = 0;
+    const char *key;
+    json_t *value;
+    json_object_foreach(object, key, value){
+        keys[i++] = scene_binary_intern_string(enc, key, strlen(key));
+    }
+    return scene_binary_intern_shape(enc, keys, count);
+}
+
+// first pass
+static void scene_binary_collect(struct scene_binary_encoder *enc, json_t *value){
+    const char *key;
+    json_t *item;
+    size_t index;
+
+    switch(json_typeof(value)){
+        case JSON_STRING:
+            scene_binary_intern_string(enc, json_string_value(value), json_string_length(value));
+            break;
+        case JSON_ARRAY:
+            json_array_foreach(value, index, item){
+                scene_binary_collect(enc, item);
+            }
+            break;
+        case JSON_OBJECT:
+            scene_binary_object_shape(enc, value);
+            json_object_foreach(value, key, item){
+                scene_binary_collect(enc, item);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// second pass, the tables already hold everything so interning only looks up
+static void scene_binary_encode_value(struct scene_binary_encoder *enc, struct scene_binary_buffer *out, json_t *value){
+    json_t *item;
+    size_t index;
+    const char *key;
+
+    switch(json_typeof(value)){
+        case JSON_NULL:
+            scene_binary_put_u8(out, SCENE_BINARY_NULL);
+            break;
+        case JSON_FALSE:
+            scene_binary_put_u8(out, SCENE_BINARY_FALSE);
+            break;
+        case JSON_TRUE:
+            scene_binary_put_u8(out, SCENE_BINARY_TRUE);
+            break;
+        case JSON_INTEGER: {
+            Sint64 v = (Sint64)json_integer_value(value);
+            scene_binary_put_u8(out, SCENE_BINARY_INT);
+            scene_binary_put_varint(out, ((Uint64)v << 1) ^ (Uint64)(v >> 63));
+            break;
+        }
+        case JSON_REAL: {
+            double v = json_real_value(value);
+            float f = (float)v;
+            if((double)f == v){
+                Uint32 bits;
+                memcpy(&bits, &f, sizeof(bits));
+                scene_binary_put_u8(out, SCENE_BINARY_F32);
+                scene_binary_put_le(out, bits, 4);
+            }
+            else{
+                Uint64 bits;
+                memcpy(&bits, &v, sizeof(bits));
+                scene_binary_put_u8(out, SCENE_BINARY_F64);
+                scene_binary_put_le(out, bits, 8);
+            }
+            break;
+        }
+        case JSON_STRING:
+            scene_binary_put_u8(out, SCENE_BINARY_STRING);
+            scene_binary_put_varint(out, scene_binary_intern_string(enc, json_string_value(value), json_string_length(value)));
+            break;
+        case JSON_ARRAY:
+            scene_binary_put_u8(out, SCENE_BINARY_ARRAY);
+            scene_binary_put_varint(out, json_array_size(value));
+            json_array_foreach(value, index, item){
+                scene_binary_encode_value(enc, out, item);
+            }
+            break;
+        case JSON_OBJECT:
+            scene_binary_put_u8(out, SCENE_BINARY_OBJECT);
+            scene_binary_put_varint(out, scene_binary_object_shape(enc, value));
+            json_object_foreach(value, key, item){
+                scene_binary_encode_value(enc, out, item);
+            }
+            break;
+    }
+}
+
+static void scene_binary_encoder_free(struct scene_binary_encoder *enc){
+    for(Uint32 i = 0; i < enc->num_shapes; i++)
+        free(enc->shapes[i].keys);
+    free(enc->shapes);
+    free(enc->shape_slots);
+    free(enc->strings);
+    free(enc->string_slots);
+}
+
+Uint8 * editor_scene_binary_encode(json_t *root, size_t *len){
+    if(!root)
+        return NULL;
+
+    struct scene_binary_encoder enc = {0};
+    scene_binary_collect(&enc, root);
+
+    struct scene_binary_buffer out = {0};
+    scene_binary_put(&out, EDITOR_SCENE_BINARY_MAGIC, 4);
+    scene_binary_put_le(&out, EDITOR_SCENE_BINARY_VERSION, 2);
+    scene_binary_put_le(&out, 0, 2);
+    scene_binary_put_le(&out, enc.num_strings, 4);
+    scene_binary_put_le(&out, enc.num_shapes, 4);
+
+    for(Uint32 i = 0; i < enc.num_strings; i++){
+        scene_binary_put_varint(&out, enc.strings[i].len);
+        scene_binary_put(&out, enc.strings[i].text, enc.strings[i].len);
+    }
+
+    for(Uint32 i = 0; i < enc.num_shapes; i++){
+        scene_binary_put_varint(&out, enc.shapes[i].count);
+        for(Uint32 k = 0; k < enc.shapes[i].count; k++)
+            scene_binary_put_varint(&out, enc.shapes[i].keys[k]);
+    }
+
+    scene_binary_encode_value(&enc, &out, root);
+
+    bool failed = enc.failed || out.failed;
+    scene_binary_encoder_free(&enc);
+    if(failed){
+        free(out.data);
+        return NULL;
+    }
+
+    *len = out.len;
+    return out.data;
+}
+
+/*
+    Decoder
+
+    Every read is bounds checked, a truncated or corrupt file fails cleanly
+    instead of reading past the buffer.
+*/
+struct scene_binary_decoder {
+    const Uint8 *data;
+    size_t len;
+    size_t pos;
+    bool failed;
+
+    Uint32 num_strings;
+    const char **strings;   // NUL terminated copies, for object keys
+    size_t *string_lens;
+    char *string_block;
+
+    Uint32 num_shapes;
+    Uint32 *shape_offsets;  // into shape_keys, num_shapes + 1 entries
+    Uint32 *shape_keys;
+
+    const char *error;      // why the tables were rejected, NULL for plain corruption
+};
+
+static bool scene_binary_get(struct scene_binary_decoder *dec, void *out, size_t len){
+    if(dec->failed || len > dec->len - dec->pos){
+        dec->failed = true;
+        return false;
+    }
+    memcpy(out, dec->data + dec->pos, len);
+    dec->pos += len;
+    return true;
+}
+
+static Uint64 scene_binary_get_le(struct scene_binary_decoder *dec, int bytes){
+    Uint8 in[8];
+    if(!scene_binary_get(dec, in, bytes))
+        return 0;
+
+    Uint64 value = 0;
+    for(int i = 0; i < bytes; i++)
+        value |= (Uint64)in[i] << (8 * i);
+    return value;
+}
+
+static Uint64 scene_binary_get_varint(struct scene_binary_decoder *dec){
+    Uint64 value = 0;
+    for(int shift = 0; shift < 64; shift += 7){
+        Uint8 byte;
+        if(!scene_binary_get(dec, &byte, 1))
+            return 0;
+        value |= (Uint64)(byte & 0x7F) << shift;
+        if(!(byte & 0x80))
+            return value;
+    }
+    dec->failed = true;
+    return 0;
+}
+
+static bool scene_binary_read_tables(struct scene_binary_decoder *dec){
+    char magic[4];
+    if(!scene_binary_get(dec, magic, 4) || memcmp(magic, EDITOR_SCENE_BINARY_MAGIC, 4) != 0){
+        dec->error = "not a binary scene";
+        return false;
+    }
+
+    Uint16 version = (Uint16)scene_binary_get_le(dec, 2);
+    scene_binary_get_le(dec, 2); // flags, none defined yet
+    if(version != EDITOR_SCENE_BINARY_VERSION){
+        dec->error = "unsupported binary scene version";
+        return false;
+    }
+
+    dec->num_strings = (Uint32)scene_binary_get_le(dec, 4);
+    dec->num_shapes = (Uint32)scene_binary_get_le(dec, 4);
+
+    // every string and shape takes at least a byte, anything more is corrupt
+    if(dec->failed || dec->num_strings > dec->len || dec->num_shapes > dec->len)
+        return false;
+
+    /*
+        Strings, copied into one block so keys are NUL terminated
+    */
+    dec->strings = calloc(dec->num_strings + 1, sizeof(char *));
+    dec->string_lens = calloc(dec->num_strings + 1, sizeof(size_t));
+    dec->string_block = malloc(dec->len);
+    if(!dec->strings || !dec->string_lens || !dec->string_block)
+        return false;
+
+    size_t block_len = 0;
+    for(Uint32 i = 0; i < dec->num_strings; i++){
+        Uint64 len = scene_binary_get_varint(dec);
+        // the block is as big as the whole file, it can not run out before the data does
+        if(dec->failed || len >= dec->len - dec->pos + 1 || block_len + len + 1 > dec->len)
+            return false;
+
+        char *text = dec->string_block + block_len;
+        scene_binary_get(dec, text, (size_t)len);
+        text[len] = '\0';
+        dec->strings[i] = text;
+        dec->string_lens[i] = (size_t)len;
+        block_len += (size_t)len + 1;
+    }
+
+    /*
+        Shapes
+    */
+    dec->shape_offsets = malloc((dec->num_shapes + 1) * sizeof(Uint32));
+    if(!dec->shape_offsets)
+        return false;
+
+    Uint32 num_keys = 0;
+    Uint32 keys_cap = 0;
+    for(Uint32 i = 0; i < dec->num_shapes; i++){
+        dec->shape_offsets[i] = num_keys;
+        Uint64 count = scene_binary_get_varint(dec);
+        // every key takes at least a byte
+        if(dec->failed || count > dec->len - dec->pos)
+            return false;
+
+        if(num_keys + count > keys_cap){
+            while(num_keys + count > keys_cap)
+                keys_cap = keys_cap ? keys_cap * 2 : 256;
+            Uint32 *grown = realloc(dec->shape_keys, keys_cap * sizeof(Uint32));
+            if(!grown)
+                return false;
+            dec->shape_keys = grown;
+        }
+
+        for(Uint64 k = 0; k < count; k++){
+            Uint64 key = scene_binary_get_varint(dec);
+            if(dec->failed || key >= dec->num_strings)
+                return false;
+            dec->shape_keys[num_keys++] = (Uint32)key;
+        }
+    }
+    dec->shape_offsets[dec->num_shapes] = num_keys;
+
+    return !dec->failed;
+}
+
+static json_t * scene_binary_decode_value(struct scene_binary_decoder *dec, int depth){
+    if(depth > EDITOR_SCENE_BINARY_MAX_DEPTH){
+        dec->failed = true;
+        return NULL;
+    }
+
+    Uint8 tag;
+    if(!scene_binary_get(dec, &tag, 1))
+        return NULL;
+
+    switch(tag){
+        case SCENE_BINARY_NULL:
+            return json_null();
+        case SCENE_BINARY_FALSE:
+            return json_false();
+        case SCENE_BINARY_TRUE:
+            return json_true();
+        case SCENE_BINARY_INT: {
+            Uint64 zigzag = scene_binary_get_varint(dec);
+            if(dec->failed)
+                return NULL;
+            return json_integer((json_int_t)((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+        }
+        case SCENE_BINARY_F32: {
+            Uint32 bits = (Uint32)scene_binary_get_le(dec, 4);
+            float f;
+            memcpy(&f, &bits, sizeof(f));
+            return dec->failed ? NULL : json_real(f);
+        }
+        case SCENE_BINARY_F64: {
+            Uint64 bits = scene_binary_get_le(dec, 8);
+            double d;
+            memcpy(&d, &bits, sizeof(d));
+            return dec->failed ? NULL : json_real(d);
+        }
+        case SCENE_BINARY_STRING: {
+            Uint64 index = scene_binary_get_varint(dec);
+            if(dec->failed || index >= dec->num_strings){
+                dec->failed = true;
+                return NULL;
+            }
+            return json_stringn(dec->strings[index], dec->string_lens[index]);
+        }
+        case SCENE_BINARY_ARRAY: {
+            Uint64 count = scene_binary_get_varint(dec);
+            // every element takes at least its tag byte
+            if(dec->failed || count > dec->len - dec->pos){
+                dec->failed = true;
+                return NULL;
+            }
+
+            json_t *array = json_array();
+            for(Uint64 i = 0; i < count && array; i++){
+                json_t *item = scene_binary_decode_value(dec, depth + 1);
+                if(!item || json_array_append_new(array, item) != 0){
+                    json_decref(array);
+                    array = NULL;
+                }
+            }
+            return array;
+        }
+        case SCENE_BINARY_OBJECT: {
+            Uint64 shape = scene_binary_get_varint(dec);
+            if(dec->failed || shape >= dec->num_shapes){
+                dec->failed = true;
+                return NULL;
+            }
+
+            json_t *object = json_object();
+            for(Uint32 k = dec->shape_offsets[shape]; k < dec->shape_offsets[shape + 1] && object; k++){
+                json_t *item = scene_binary_decode_value(dec, depth + 1);
+                if(!item || json_object_set_new(object, dec->strings[dec->shape_keys[k]], item) != 0){
+                    json_decref(object);
+                    object = NULL;
+                }
+            }
+            return object;
+        }
+        default:
+            dec->failed = true;
+            return NULL;
+    }
+}
+
+json_t * editor_scene_binary_decode(const Uint8 *data, size_t len, char *error, size_t error_size){
+    struct scene_binary_decoder dec = {0};
+    dec.data = data;
+    dec.len = len;
+
+    json_t *root = NULL;
+    if(scene_binary_read_tables(&dec))
+        root = scene_binary_decode_value(&dec, 0);
+
+    // trailing bytes mean we did not read what was written
+    if(root && (dec.failed || dec.pos != dec.len)){
+        json_decref(root);
+        root = NULL;
+    }
+    if(!root)
+        scene_binary_error(error, error_size, "%s", dec.error ? dec.error : "malformed binary scene data");
+
+    free(dec.strings);
+    free(dec.string_lens);
+    free(dec.string_block);
+    free(dec.shape_offsets);
+    free(dec.shape_keys);
+    return root;
+}
+
+/*
+    Files
+*/
+bool editor_scene_binary_write(const char *path, json_t *root, char *error, size_t error_size){
+    size_t len = 0;
+    Uint8 *data = editor_scene_binary_encode(root, &len);
+    if(!data){
+        scene_binary_error(error, error_size, "failed to encode the scene (out of memory)");
+        return false;
+    }
+
+    // same as scene saves, a failed write leaves the old file alone
+    char tmp_path[1100];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    bool ok = SDL_SaveFile(tmp_path, data, len) && SDL_RenamePath(tmp_path, path);
+    if(!ok){
+        scene_binary_error(error, error_size, "failed to write %s: %s", path, SDL_GetError());
+        SDL_RemovePath(tmp_path);
+    }
+
+    free(data);
+    return ok;
+}
+
+json_t * editor_scene_binary_read(const char *path, char *error, size_t error_size){
+    size_t len = 0;
+    void *data = SDL_LoadFile(path, &len);
+    if(!data){
+        scene_binary_error(error, error_size, "failed to read %s: %s", path, SDL_GetError());
+        return NULL;
+    }
+
+    json_t *root = editor_scene_binary_decode(data, len, error, error_size);
+    SDL_free(data);
+    return root;
+}
+
+bool editor_scene_binary_from_json(const char *json_path, const char *binary_path, char *error, size_t error_size){
+    json_error_t err;
+    json_t *root = json_load_file(json_path, 0, &err);
+    if(!root){
+        scene_binary_error(error, error_size, "failed to parse %s: %s (line %d)", json_path, err.text, err.line);
+        return false;
+    }
+
+    bool ok = editor_scene_binary_write(binary_path, root, error, error_size);
+    json_decref(root);
+    return ok;
+}
+
+bool editor_scene_binary_to_json(const char *binary_path, const char *json_path, char *error, size_t error_size){
+    json_t *root = editor_scene_binary_read(binary_path, error, error_size);
+    if(!root)
+        return false;
+
+    bool ok = json_dump_file(root, json_path, JSON_INDENT(4)) == 0;
+    json_decref(root);
+    if(!ok)
+        scene_binary_error(error, error_size, "failed to write %s", json_path);
+    return ok;
+}
+
+void editor_scene_binary_path(const char *json_path, char *out, size_t size){
+    const char *dot = strrchr(json_path, '.');
+    const char *slash = strrchr(json_path, '/');
+    int stem = (dot && (!slash || dot > slash)) ? (int)(dot - json_path) : (int)strlen(json_path);
+    snprintf(out, size, "%.*s%s", stem, json_path, EDITOR_SCENE_BINARY_EXTENSION);
+}
+
+/*
+    Benchmark
+*/
+static double scene_binary_ms_since(Uint64 start){
+    return (SDL_GetTicksNS() - start) / 1e6;
+}
+
+static void scene_binary_best(double *best, double ms){
+    if(*best < 0 || ms < *best)
+        *best = ms;
+}
+
+bool editor_scene_binary_benchmark(const char *json_path, int iterations, struct editor_scene_binary_benchmark *out, char *error, size_t error_size){
+    memset(out, 0, sizeof(*out));
+    out->json_load_ms = out->json_save_ms = out->binary_load_ms = out->binary_save_ms = -1;
+
+    size_t text_len = 0;
+    char *text = SDL_LoadFile(json_path, &text_len);
+    if(!text){
+        scene_binary_error(error, error_size, "failed to read %s: %s", json_path, SDL_GetError());
+        return false;
+    }
+    out->json_bytes = text_len;
+
+    json_error_t err;
+    json_t *reference = json_loadb(text, text_len, 0, &err);
+    if(!reference){
+        scene_binary_error(error, error_size, "failed to parse %s: %s (line %d)", json_path, err.text, err.line);
+        SDL_free(text);
+        return false;
+    }
+
+    bool ok = true;
+    for(int i = 0; i < iterations && ok; i++){
+        Uint64 start = SDL_GetTicksNS();
+        json_t *parsed = json_loadb(text, text_len, 0, &err);
+        scene_binary_best(&out->json_load_ms, scene_binary_ms_since(start));
+
+        start = SDL_GetTicksNS();
+        char *dumped = json_dumps(reference, JSON_INDENT(4));
+        scene_binary_best(&out->json_save_ms, scene_binary_ms_since(start));
+
+        size_t binary_len = 0;
+        start = SDL_GetTicksNS();
+        Uint8 *binary = editor_scene_binary_encode(reference, &binary_len);
+        scene_binary_best(&out->binary_save_ms, scene_binary_ms_since(start));
+
+        json_t *decoded = NULL;
+        if(binary){
+            start = SDL_GetTicksNS();
+            decoded = editor_scene_binary_decode(binary, binary_len, error, error_size);
+            scene_binary_best(&out->binary_load_ms, scene_binary_ms_since(start));
+        }
+
+        // a failed decode already described itself
+        ok = parsed && dumped && decoded;
+        if(!ok && (!binary || decoded))
+            scene_binary_error(error, error_size, "out of memory");
+
+        // lossless means the same tree, and the same text once dumped (key order included)
+        if(ok && i == 0){
+            out->binary_bytes = binary_len;
+            char *redumped = json_dumps(decoded, JSON_INDENT(4));
+            out->lossless = json_equal(decoded, reference) && redumped && strcmp(redumped, dumped) == 0;
+            free(redumped);
+        }
+
+        json_decref(parsed);
+        json_decref(decoded);
+        free(dumped);
+        free(binary);
+    }
+
+    json_decref(reference);
+    SDL_free(text);
+
+    out->iterations = iterations;
+    return ok;
+}
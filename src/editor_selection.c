@@ -18,6 +18,7 @@
 #include "editor_input.h"
 #include "editor_ui.h"
 #include "editor_selection.h"
+#include "editor_serialize.h"
 
 bool is_dragging = false;
 SDL_Point drag_start;
@@ -34,6 +35,9 @@ void editor_deselect_all(){
     while(itr != NULL){
         struct editor_selection_node * temp = itr;
         itr = itr->next;
+
+        // whatever the inspector did to it has to be saved
+        editor_serialize_mark_dirty(temp->ent);
         free(temp);
     }
     editor_selections = NULL;
@@ -396,6 +400,7 @@ void editor_deselect(struct ye_entity * ent){
     struct editor_selection_node * prev = NULL;
     while(itr != NULL){
         if(itr->ent == ent){
+            editor_serialize_mark_dirty(ent);
             if(prev == NULL){
                 editor_selections = itr->next;
             }
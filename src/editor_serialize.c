@@ -6,16 +6,26 @@
 */
 
 #include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "editor.h"
+#include "editor_serialize.h"
+#include "editor_selection.h"
+#include "editor_json_writer.h"
+#include "editor_scene_binary.h"
 
 #include <yoyoengine/yoyoengine.h>
 
 /*
-    Begin helper methods to serialize different type of objects into json_t
+    Begin helper methods to serialize different type of objects
 
     Their data is already fully initialized in structs, so we dont have to
-    do nearly as much error checking as if we were deserializing
+    do nearly as much error checking as if we were deserializing.
+
+    Everything is streamed straight into an editor_json_writer (in the order
+    the keys appear in the file) instead of building a json_t tree first.
 
     NOTE: maybe worth doing a few checks to not write any zero or unintialized fields to save space?
     Counter: premature optimization is the root of all evil
@@ -26,228 +36,281 @@
 
     NOTE TODO: we are converting a float to an int to serialize back into a float from an int. pepega
 */
-void serialize_entity_transform(struct ye_entity *entity, json_t *entity_json){
-    // create the transform object
-    json_t *transform = json_object();
-    
+void serialize_entity_transform(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "transform");
+    editor_json_writer_begin_object(writer);
+
     // set the x
-    json_object_set_new(transform, "x", json_real(entity->transform->x));
+    editor_json_writer_key(writer, "x");
+    editor_json_writer_real(writer, entity->transform->x);
 
     // set the y
-    json_object_set_new(transform, "y", json_real(entity->transform->y));
+    editor_json_writer_key(writer, "y");
+    editor_json_writer_real(writer, entity->transform->y);
 
     // set the rotation
-    json_object_set_new(transform, "rotation", json_real(entity->transform->rotation));
+    editor_json_writer_key(writer, "rotation");
+    editor_json_writer_real(writer, entity->transform->rotation);
 
-    // set the transform object
-    json_object_set_new(entity_json, "transform", transform);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_camera(struct ye_entity *entity, json_t *entity_json){
-    // create the camera object
-    json_t *camera = json_object();
+void serialize_entity_camera(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "camera");
+    editor_json_writer_begin_object(writer);
 
     // set the active state
-    json_object_set_new(camera, "active", json_boolean(entity->camera->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->camera->active);
 
     // set the z
-    json_object_set_new(camera, "z", json_integer(entity->camera->z));
-
-    // set the view field object
-    json_t *view_field = json_object();
-    json_object_set_new(view_field, "x", json_real(entity->camera->view_field.x));
-    json_object_set_new(view_field, "y", json_real(entity->camera->view_field.y));
-    json_object_set_new(view_field, "w", json_real(entity->camera->view_field.w));
-    json_object_set_new(view_field, "h", json_real(entity->camera->view_field.h));
-
-    // set the camera object
-    json_object_set_new(entity_json, "camera", camera);
+    editor_json_writer_key(writer, "z");
+    editor_json_writer_integer(writer, entity->camera->z);
 
     // set the view field object
-    json_object_set_new(camera, "view field", view_field);
+    editor_json_writer_key(writer, "view field");
+    editor_json_writer_begin_object(writer);
+    editor_json_writer_key(writer, "x");
+    editor_json_writer_real(writer, entity->camera->view_field.x);
+    editor_json_writer_key(writer, "y");
+    editor_json_writer_real(writer, entity->camera->view_field.y);
+    editor_json_writer_key(writer, "w");
+    editor_json_writer_real(writer, entity->camera->view_field.w);
+    editor_json_writer_key(writer, "h");
+    editor_json_writer_real(writer, entity->camera->view_field.h);
+    editor_json_writer_end_object(writer);
 
     // set the lock aspect ratio
-    json_object_set_new(camera, "lock aspect ratio", json_boolean(entity->camera->lock_aspect_ratio));
+    editor_json_writer_key(writer, "lock aspect ratio");
+    editor_json_writer_boolean(writer, entity->camera->lock_aspect_ratio);
+
+    editor_json_writer_end_object(writer);
 }
 
 /*
     NOTE TODO: same thing here, pepega
 */
-void serialize_entity_position(struct ye_rectf *position, json_t *parent){
-    // create the position object
-    json_t *position_json = json_object();
+void serialize_entity_position(struct ye_rectf *position, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "position");
+    editor_json_writer_begin_object(writer);
 
     // set the x
-    json_object_set_new(position_json, "x", json_integer((int)position->x));
+    editor_json_writer_key(writer, "x");
+    editor_json_writer_integer(writer, (int)position->x);
 
     // set the y
-    json_object_set_new(position_json, "y", json_integer((int)position->y));
+    editor_json_writer_key(writer, "y");
+    editor_json_writer_integer(writer, (int)position->y);
 
     // set the w
-    json_object_set_new(position_json, "w", json_integer((int)position->w));
+    editor_json_writer_key(writer, "w");
+    editor_json_writer_integer(writer, (int)position->w);
 
     // set the h
-    json_object_set_new(position_json, "h", json_integer((int)position->h));
+    editor_json_writer_key(writer, "h");
+    editor_json_writer_integer(writer, (int)position->h);
 
-    // set the position object
-    json_object_set_new(parent, "position", position_json);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_renderer(struct ye_entity *entity, json_t *entity_json){
-    // create the renderer object
-    json_t *renderer = json_object();
+void serialize_entity_renderer(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "renderer");
+    editor_json_writer_begin_object(writer);
 
     // set the active state
-    json_object_set_new(renderer, "active", json_boolean(entity->renderer->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->renderer->active);
 
     // set the type integer
-    json_object_set_new(renderer, "type", json_integer(entity->renderer->type));
+    editor_json_writer_key(writer, "type");
+    editor_json_writer_integer(writer, entity->renderer->type);
 
     // set the flip booleans
-    json_object_set_new(renderer, "flipped_x", json_boolean(entity->renderer->flipped_x));
-    json_object_set_new(renderer, "flipped_y", json_boolean(entity->renderer->flipped_y));
+    editor_json_writer_key(writer, "flipped_x");
+    editor_json_writer_boolean(writer, entity->renderer->flipped_x);
+    editor_json_writer_key(writer, "flipped_y");
+    editor_json_writer_boolean(writer, entity->renderer->flipped_y);
 
     // center_x, center_y
-    json_object_set_new(renderer, "center_x", json_integer(entity->renderer->center.x));
-    json_object_set_new(renderer, "center_y", json_integer(entity->renderer->center.y));
+    editor_json_writer_key(writer, "center_x");
+    editor_json_writer_integer(writer, entity->renderer->center.x);
+    editor_json_writer_key(writer, "center_y");
+    editor_json_writer_integer(writer, entity->renderer->center.y);
 
     // set the z layer
-    json_object_set_new(renderer, "z", json_integer(entity->renderer->z));
+    editor_json_writer_key(writer, "z");
+    editor_json_writer_integer(writer, entity->renderer->z);
 
     // set the alignment
-    json_object_set_new(renderer, "alignment", json_integer(entity->renderer->alignment));
+    editor_json_writer_key(writer, "alignment");
+    editor_json_writer_integer(writer, entity->renderer->alignment);
 
     // set the "preserve size"
-    json_object_set_new(renderer, "preserve size", json_boolean(entity->renderer->preserve_original_size));
+    editor_json_writer_key(writer, "preserve size");
+    editor_json_writer_boolean(writer, entity->renderer->preserve_original_size);
 
     // set the position object
-    serialize_entity_position(&entity->renderer->rect, renderer);
+    serialize_entity_position(&entity->renderer->rect, writer);
 
     // set the roatation
-    json_object_set_new(renderer, "rotation", json_real(entity->renderer->rotation));
+    editor_json_writer_key(writer, "rotation");
+    editor_json_writer_real(writer, entity->renderer->rotation);
 
     // aspect ratio lock
-    json_object_set_new(renderer, "lock aspect ratio", json_boolean(entity->renderer->lock_aspect_ratio));
+    editor_json_writer_key(writer, "lock aspect ratio");
+    editor_json_writer_boolean(writer, entity->renderer->lock_aspect_ratio);
 
     // alpha
-    json_object_set_new(renderer, "alpha", json_integer(entity->renderer->alpha));
+    editor_json_writer_key(writer, "alpha");
+    editor_json_writer_integer(writer, entity->renderer->alpha);
 
     // and now the fun part... the renderer specific impl
-
-    // create impl object
-    json_t *impl = json_object();
+    editor_json_writer_key(writer, "impl");
+    editor_json_writer_begin_object(writer);
 
     switch(entity->renderer->type){
         case YE_RENDERER_TYPE_IMAGE:
             // set the src
-            json_object_set_new(impl, "src", json_string(entity->renderer->renderer_impl.image->src));
+            editor_json_writer_key(writer, "src");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.image->src);
             break;
         case YE_RENDERER_TYPE_TEXT:
             // set the text
-            json_object_set_new(impl, "text", json_string(entity->renderer->renderer_impl.text->text));
-            
-            json_object_set_new(impl, "color", json_string(entity->renderer->renderer_impl.text->color_name));
-            json_object_set_new(impl, "font", json_string(entity->renderer->renderer_impl.text->font_name));
+            editor_json_writer_key(writer, "text");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text->text);
+
+            editor_json_writer_key(writer, "color");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text->color_name);
+            editor_json_writer_key(writer, "font");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text->font_name);
 
             // set the font size
-            json_object_set_new(impl, "font_size", json_integer(entity->renderer->renderer_impl.text->font_size));
+            editor_json_writer_key(writer, "font_size");
+            editor_json_writer_integer(writer, entity->renderer->renderer_impl.text->font_size);
 
             // set wrap bool
-            json_object_set_new(impl, "wrap_width", json_integer(entity->renderer->renderer_impl.text->wrap_width));
+            editor_json_writer_key(writer, "wrap_width");
+            editor_json_writer_integer(writer, entity->renderer->renderer_impl.text->wrap_width);
 
             break;
         case YE_RENDERER_TYPE_TEXT_OUTLINED:
             // set the text
-            json_object_set_new(impl, "text", json_string(entity->renderer->renderer_impl.text_outlined->text));
+            editor_json_writer_key(writer, "text");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text_outlined->text);
 
             // set the outline size
-            json_object_set_new(impl, "outline size", json_integer(entity->renderer->renderer_impl.text_outlined->outline_size));
+            editor_json_writer_key(writer, "outline size");
+            editor_json_writer_integer(writer, entity->renderer->renderer_impl.text_outlined->outline_size);
 
             /*
                 We run into the same font and color issue here as above- :3
             */
-            json_object_set_new(impl, "color", json_string(entity->renderer->renderer_impl.text_outlined->color_name));
-            json_object_set_new(impl, "font", json_string(entity->renderer->renderer_impl.text_outlined->font_name));
+            editor_json_writer_key(writer, "color");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text_outlined->color_name);
+            editor_json_writer_key(writer, "font");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text_outlined->font_name);
 
             // set the font size
-            json_object_set_new(impl, "font_size", json_integer(entity->renderer->renderer_impl.text_outlined->font_size));
+            editor_json_writer_key(writer, "font_size");
+            editor_json_writer_integer(writer, entity->renderer->renderer_impl.text_outlined->font_size);
 
-            json_object_set_new(impl, "outline color", json_string(entity->renderer->renderer_impl.text_outlined->outline_color_name));
+            editor_json_writer_key(writer, "outline color");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.text_outlined->outline_color_name);
 
             // set wrap bool
-            json_object_set_new(impl, "wrap_width", json_integer(entity->renderer->renderer_impl.text_outlined->wrap_width));
+            editor_json_writer_key(writer, "wrap_width");
+            editor_json_writer_integer(writer, entity->renderer->renderer_impl.text_outlined->wrap_width);
 
             break;
         case YE_RENDERER_TYPE_ANIMATION:
             // set the animation path
-            json_object_set_new(impl, "animation path", json_string(entity->renderer->renderer_impl.animation->meta_file));
+            editor_json_writer_key(writer, "animation path");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.animation->meta_file);
 
             break;
         case YE_RENDERER_TYPE_TILEMAP_TILE:
             // set the tilemap path
-            json_object_set_new(impl, "handle", json_string(entity->renderer->renderer_impl.tile->handle));
+            editor_json_writer_key(writer, "handle");
+            editor_json_writer_string(writer, entity->renderer->renderer_impl.tile->handle);
 
             // set the tilemap "position" in its source image
             struct ye_rectf pos = ye_convert_rect_rectf(entity->renderer->renderer_impl.tile->src);
-            serialize_entity_position(&pos, impl);
+            serialize_entity_position(&pos, writer);
 
             break;
         default:
             ye_logf(warning, "ermmm... this shouldnt have happend!");
     }
 
-    // set the renderer object
-    json_object_set_new(entity_json, "renderer", renderer);
-
-    // set the impl object
-    json_object_set_new(renderer, "impl", impl);
+    // close the impl and the renderer
+    editor_json_writer_end_object(writer);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_rigidbody(struct ye_entity *entity, json_t *entity_json){
-    // create the rigidbody object
-    json_t *rigidbody = json_object();
+void serialize_entity_rigidbody(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "rigidbody");
+    editor_json_writer_begin_object(writer);
 
-    json_object_set_new(rigidbody, "active", json_boolean(entity->rigidbody->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->rigidbody->active);
 
-    json_object_set_new(rigidbody, "transform_offset_x", json_real(entity->rigidbody->transform_offset_x));
-    json_object_set_new(rigidbody, "transform_offset_y", json_real(entity->rigidbody->transform_offset_y));
+    editor_json_writer_key(writer, "transform_offset_x");
+    editor_json_writer_real(writer, entity->rigidbody->transform_offset_x);
+    editor_json_writer_key(writer, "transform_offset_y");
+    editor_json_writer_real(writer, entity->rigidbody->transform_offset_y);
 
     // p2d object
-    json_t *p2d_object = json_object();
-
-    json_object_set_new(p2d_object, "type", json_integer(entity->rigidbody->p2d_object.type));
-    json_object_set_new(p2d_object, "is_static", json_boolean(entity->rigidbody->p2d_object.is_static));
-    json_object_set_new(p2d_object, "is_trigger", json_boolean(entity->rigidbody->p2d_object.is_trigger));
-    json_object_set_new(p2d_object, "vx", json_real(entity->rigidbody->p2d_object.vx));
-    json_object_set_new(p2d_object, "vy", json_real(entity->rigidbody->p2d_object.vy));
-    json_object_set_new(p2d_object, "vr", json_real(entity->rigidbody->p2d_object.vr));
-    json_object_set_new(p2d_object, "density", json_real(entity->rigidbody->p2d_object.density));
-    json_object_set_new(p2d_object, "restitution", json_real(entity->rigidbody->p2d_object.restitution));
-    json_object_set_new(p2d_object, "mask", json_integer(entity->rigidbody->p2d_object.mask));
+    editor_json_writer_key(writer, "p2d_object");
+    editor_json_writer_begin_object(writer);
+
+    editor_json_writer_key(writer, "type");
+    editor_json_writer_integer(writer, entity->rigidbody->p2d_object.type);
+    editor_json_writer_key(writer, "is_static");
+    editor_json_writer_boolean(writer, entity->rigidbody->p2d_object.is_static);
+    editor_json_writer_key(writer, "is_trigger");
+    editor_json_writer_boolean(writer, entity->rigidbody->p2d_object.is_trigger);
+    editor_json_writer_key(writer, "vx");
+    editor_json_writer_real(writer, entity->rigidbody->p2d_object.vx);
+    editor_json_writer_key(writer, "vy");
+    editor_json_writer_real(writer, entity->rigidbody->p2d_object.vy);
+    editor_json_writer_key(writer, "vr");
+    editor_json_writer_real(writer, entity->rigidbody->p2d_object.vr);
+    editor_json_writer_key(writer, "density");
+    editor_json_writer_real(writer, entity->rigidbody->p2d_object.density);
+    editor_json_writer_key(writer, "restitution");
+    editor_json_writer_real(writer, entity->rigidbody->p2d_object.restitution);
+    editor_json_writer_key(writer, "mask");
+    editor_json_writer_integer(writer, entity->rigidbody->p2d_object.mask);
 
     switch(entity->rigidbody->p2d_object.type) {
         case P2D_OBJECT_RECTANGLE:
-            json_object_set_new(p2d_object, "width", json_real(entity->rigidbody->p2d_object.rectangle.width));
-            json_object_set_new(p2d_object, "height", json_real(entity->rigidbody->p2d_object.rectangle.height));
+            editor_json_writer_key(writer, "width");
+            editor_json_writer_real(writer, entity->rigidbody->p2d_object.rectangle.width);
+            editor_json_writer_key(writer, "height");
+            editor_json_writer_real(writer, entity->rigidbody->p2d_object.rectangle.height);
             break;
         case P2D_OBJECT_CIRCLE:
-            json_object_set_new(p2d_object, "radius", json_real(entity->rigidbody->p2d_object.circle.radius));
+            editor_json_writer_key(writer, "radius");
+            editor_json_writer_real(writer, entity->rigidbody->p2d_object.circle.radius);
             break;
     }
 
-    json_object_set_new(rigidbody, "p2d_object", p2d_object);
-    json_object_set_new(entity_json, "rigidbody", rigidbody);
+    // close the p2d object and the rigidbody
+    editor_json_writer_end_object(writer);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_tag(struct ye_entity *entity, json_t *entity_json){
-    // create the tag object
-    json_t *tag = json_object();
+void serialize_entity_tag(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "tag");
+    editor_json_writer_begin_object(writer);
 
     // set the active state
-    json_object_set_new(tag, "active", json_boolean(entity->tag->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->tag->active);
 
     // set the tags array
-    json_t *tags = json_array();
+    editor_json_writer_key(writer, "tags");
+    editor_json_writer_begin_array(writer);
 
     // for each tag in the entity, add it to the tags array
     for(int i = 0; i < YE_TAG_MAX_NUMBER; i++){
@@ -256,82 +319,475 @@ void serialize_entity_tag(struct ye_entity *entity, json_t *entity_json){
             continue;
         }
 
-        json_array_append_new(tags, json_string(entity->tag->tags[i]));
+        editor_json_writer_string(writer, entity->tag->tags[i]);
     }
 
-    // add the tags array to the tag object
-    json_object_set_new(tag, "tags", tags);
-
-    // add the tag object to the entity json
-    json_object_set_new(entity_json, "tag", tag);
+    editor_json_writer_end_array(writer);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_audiosource(struct ye_entity *entity, json_t *entity_json){
-    // create the audiosource object
-    json_t *audiosource = json_object();
+void serialize_entity_audiosource(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "audiosource");
+    editor_json_writer_begin_object(writer);
 
     // set the active state
-    json_object_set_new(audiosource, "active", json_boolean(entity->audiosource->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->audiosource->active);
 
     // set the simulated
-    json_object_set_new(audiosource, "simulated", json_boolean(entity->audiosource->simulated));
+    editor_json_writer_key(writer, "simulated");
+    editor_json_writer_boolean(writer, entity->audiosource->simulated);
 
     // set the (src) handle
-    json_object_set_new(audiosource, "src", json_string(entity->audiosource->handle));
+    editor_json_writer_key(writer, "src");
+    editor_json_writer_string(writer, entity->audiosource->handle);
 
     // set the volume
-    json_object_set_new(audiosource, "volume", json_real(entity->audiosource->volume));
+    editor_json_writer_key(writer, "volume");
+    editor_json_writer_real(writer, entity->audiosource->volume);
 
     // set the range
-    json_t *range = json_object();
-    json_object_set_new(range, "x", json_integer(entity->audiosource->range.x));
-    json_object_set_new(range, "y", json_integer(entity->audiosource->range.y));
-    json_object_set_new(range, "w", json_integer(entity->audiosource->range.w));
-    json_object_set_new(range, "h", json_integer(entity->audiosource->range.h));
-    json_object_set_new(audiosource, "position", range);
+    editor_json_writer_key(writer, "position");
+    editor_json_writer_begin_object(writer);
+    editor_json_writer_key(writer, "x");
+    editor_json_writer_integer(writer, entity->audiosource->range.x);
+    editor_json_writer_key(writer, "y");
+    editor_json_writer_integer(writer, entity->audiosource->range.y);
+    editor_json_writer_key(writer, "w");
+    editor_json_writer_integer(writer, entity->audiosource->range.w);
+    editor_json_writer_key(writer, "h");
+    editor_json_writer_integer(writer, entity->audiosource->range.h);
+    editor_json_writer_end_object(writer);
 
     // set the relative
-    json_object_set_new(audiosource, "relative", json_boolean(entity->audiosource->relative));
+    editor_json_writer_key(writer, "relative");
+    editor_json_writer_boolean(writer, entity->audiosource->relative);
 
     // set the play on awake
-    json_object_set_new(audiosource, "play on awake", json_boolean(entity->audiosource->play_on_awake));
+    editor_json_writer_key(writer, "play on awake");
+    editor_json_writer_boolean(writer, entity->audiosource->play_on_awake);
 
     // set the loops
-    json_object_set_new(audiosource, "loops", json_integer(entity->audiosource->loops));
+    editor_json_writer_key(writer, "loops");
+    editor_json_writer_integer(writer, entity->audiosource->loops);
 
-    // add the audiosource object to the entity json
-    json_object_set_new(entity_json, "audiosource", audiosource);
+    editor_json_writer_end_object(writer);
 }
 
-void serialize_entity_button(struct ye_entity *entity, json_t *entity_json){
-    // create the button object
-    json_t *button = json_object();
+void serialize_entity_button(struct ye_entity *entity, struct editor_json_writer *writer){
+    editor_json_writer_key(writer, "button");
+    editor_json_writer_begin_object(writer);
 
     // set the active state
-    json_object_set_new(button, "active", json_boolean(entity->button->active));
+    editor_json_writer_key(writer, "active");
+    editor_json_writer_boolean(writer, entity->button->active);
 
     // set the relative
-    json_object_set_new(button, "relative", json_boolean(entity->button->relative));
+    editor_json_writer_key(writer, "relative");
+    editor_json_writer_boolean(writer, entity->button->relative);
 
     // set the position
-    serialize_entity_position(&entity->button->rect, button);
+    serialize_entity_position(&entity->button->rect, writer);
+
+    editor_json_writer_end_object(writer);
+}
+
+/*
+    Serialize a whole entity, the components object only holds the components it has.
+    Entities sit at depth 3 of the scene file ({"scene": {"entities": [...]}}),
+    the text is written at that indentation so it can be spliced in as is
+*/
+#define SERIALIZE_ENTITY_DEPTH 3
+
+static char * serialize_entity(struct ye_entity *entity, size_t *len){
+    struct editor_json_writer writer;
+    editor_json_writer_init(&writer, NULL, SERIALIZE_ENTITY_DEPTH);
+    editor_json_writer_begin_object(&writer);
+
+    // set the name
+    editor_json_writer_key(&writer, "name");
+    editor_json_writer_string(&writer, entity->name);
+
+    // set the active status
+    editor_json_writer_key(&writer, "active");
+    editor_json_writer_boolean(&writer, entity->active);
+
+    // create the components object
+    editor_json_writer_key(&writer, "components");
+    editor_json_writer_begin_object(&writer);
+
+    if(entity->transform != NULL){
+        serialize_entity_transform(entity, &writer);
+    }
+
+    if(entity->camera != NULL){
+        serialize_entity_camera(entity, &writer);
+    }
+
+    if(entity->renderer != NULL){
+        serialize_entity_renderer(entity, &writer);
+    }
+
+    if(entity->rigidbody != NULL){
+        serialize_entity_rigidbody(entity, &writer);
+    }
+
+    if(entity->tag != NULL){
+        serialize_entity_tag(entity, &writer);
+    }
+
+    if(entity->audiosource != NULL){
+        serialize_entity_audiosource(entity, &writer);
+    }
+
+    if(entity->button != NULL){
+        serialize_entity_button(entity, &writer);
+    }
+
+    editor_json_writer_end_object(&writer);
+    editor_json_writer_end_object(&writer);
+
+    return editor_json_writer_take(&writer, len);
+}
+
+/*
+    Entity cache
+
+    Open addressed table from entity pointer to the text it was last saved as.
+    Dirty entities keep their slot with a NULL chunk. The component pointers
+    are remembered too, adding or removing a component (or a new entity
+    reusing a freed pointer) then misses the cache even if nobody marked it.
+    Every save rebuilds the table from the entities it wrote, which drops
+    entries of destroyed entities.
+
+    Chunks are shared between the table and a running save, the references
+    are only ever touched on the main thread.
+*/
+#define SERIALIZE_CACHE_COMPONENTS 7
+
+struct serialize_chunk {
+    int refs;
+    size_t len;
+    char text[];
+};
+
+struct serialize_cache_entry {
+    struct ye_entity *entity;       // NULL for an empty slot
+    struct serialize_chunk *chunk;  // NULL while dirty
+    void *components[SERIALIZE_CACHE_COMPONENTS];
+};
+
+static struct serialize_cache_entry *serialize_cache = NULL;
+static size_t serialize_cache_capacity = 0; // power of two
+
+/*
+    The scene file as last read or written, everything but its entities is
+    reused. The entities array is emptied once read, they are always written
+    from the chunks.
+*/
+static json_t *serialize_scene = NULL;
+static char serialize_scene_path[1024] = "";
+static SDL_Time serialize_scene_mtime = 0;
+
+static struct serialize_chunk * serialize_chunk_create(struct ye_entity *entity){
+    size_t len = 0;
+    char *text = serialize_entity(entity, &len);
+    if(!text)
+        return NULL;
+
+    struct serialize_chunk *chunk = malloc(sizeof(struct serialize_chunk) + len + 1);
+    if(chunk){
+        chunk->refs = 1;
+        chunk->len = len;
+        memcpy(chunk->text, text, len + 1);
+    }
+    free(text);
+    return chunk;
+}
 
-    // add the button object to the entity json
-    json_object_set_new(entity_json, "button", button);
+static void serialize_chunk_release(struct serialize_chunk *chunk){
+    if(chunk && --chunk->refs == 0)
+        free(chunk);
+}
+
+static void serialize_cache_components(struct ye_entity *entity, void **out){
+    out[0] = entity->transform;
+    out[1] = entity->camera;
+    out[2] = entity->renderer;
+    out[3] = entity->rigidbody;
+    out[4] = entity->tag;
+    out[5] = entity->audiosource;
+    out[6] = entity->button;
+}
+
+static struct serialize_cache_entry * serialize_cache_slot(struct serialize_cache_entry *table, size_t capacity, struct ye_entity *entity){
+    Uint64 hash = ((Uint64)(uintptr_t)entity >> 4) * 0x9E3779B97F4A7C15ull;
+    size_t i = (size_t)(hash >> 32) & (capacity - 1);
+    while(table[i].entity != NULL && table[i].entity != entity)
+        i = (i + 1) & (capacity - 1);
+    return &table[i];
+}
+
+static void serialize_cache_free(struct serialize_cache_entry *table, size_t capacity){
+    for(size_t i = 0; i < capacity; i++)
+        serialize_chunk_release(table[i].chunk);
+    free(table);
+}
+
+void editor_serialize_mark_dirty(struct ye_entity *entity){
+    if(!serialize_cache || !entity)
+        return;
+
+    struct serialize_cache_entry *slot = serialize_cache_slot(serialize_cache, serialize_cache_capacity, entity);
+    if(slot->entity && slot->chunk){
+        serialize_chunk_release(slot->chunk);
+        slot->chunk = NULL;
+    }
+}
+
+void editor_serialize_invalidate(){
+    if(serialize_cache)
+        serialize_cache_free(serialize_cache, serialize_cache_capacity);
+    serialize_cache = NULL;
+    serialize_cache_capacity = 0;
+
+    if(serialize_scene)
+        json_decref(serialize_scene);
+    serialize_scene = NULL;
+    serialize_scene_path[0] = '\0';
+}
+
+/*
+    The scene file is only parsed again if something else wrote it since we
+    last did, e.g. the scene settings or a text editor
+*/
+static json_t * serialize_load_scene(const char *path){
+    SDL_PathInfo info;
+    SDL_Time mtime = SDL_GetPathInfo(path, &info) ? info.modify_time : 0;
+
+    if(serialize_scene && strcmp(serialize_scene_path, path) == 0 && mtime == serialize_scene_mtime)
+        return serialize_scene;
+
+    if(serialize_scene)
+        json_decref(serialize_scene);
+    serialize_scene = ye_json_read(path);
+    snprintf(serialize_scene_path, sizeof(serialize_scene_path), "%s", path);
+    serialize_scene_mtime = mtime;
+
+    // the parsed entities are never used, dont keep them around
+    json_t *scene_obj = json_object_get(serialize_scene, "scene");
+    if(json_is_object(scene_obj))
+        json_object_set_new(scene_obj, "entities", json_array());
+
+    return serialize_scene;
+}
+
+/*
+    Background save
+
+    The main thread only brings the entity chunks up to date (which
+    serializes just the dirty entities), the worker streams the document
+    to disk. One save runs at a time, the document is not touched by the
+    main thread until the worker is joined. A save requested meanwhile is
+    folded into one follow-up save that starts once the running one is reaped.
+*/
+static SDL_Thread *save_thread = NULL;
+static SDL_AtomicInt save_finished;
+static json_t *save_doc = NULL;     // reference held for the worker
+static struct serialize_chunk **save_chunks = NULL; // references held for the worker
+static int save_num_chunks = 0;
+static char save_path[1024];
+static bool save_ok = false;
+static Uint64 save_start_ticks = 0;
+static int save_num_serialized = 0;
+static bool save_binary = false;  // also write the .yoyob copy (project setting "binary_scenes")
+static bool save_binary_ok = false;
+static char save_binary_error[512]; // logged at reap, the worker never logs
+static bool save_queued = false;
+static char save_queued_path[1024];
+
+/*
+    Writes the scene document, splicing the cached entity text in as the
+    "entities" array of the "scene" object
+*/
+static void serialize_write_document(struct editor_json_writer *writer){
+    editor_json_writer_begin_object(writer);
+
+    const char *key;
+    json_t *value;
+    json_object_foreach(save_doc, key, value){
+        editor_json_writer_key(writer, key);
+        if(strcmp(key, "scene") != 0 || !json_is_object(value)){
+            editor_json_writer_value(writer, value);
+            continue;
+        }
+
+        editor_json_writer_begin_object(writer);
+
+        const char *scene_key;
+        json_t *scene_value;
+        json_object_foreach(value, scene_key, scene_value){
+            editor_json_writer_key(writer, scene_key);
+            if(strcmp(scene_key, "entities") != 0){
+                editor_json_writer_value(writer, scene_value);
+                continue;
+            }
+
+            editor_json_writer_begin_array(writer);
+            for(int i = 0; i < save_num_chunks; i++)
+                editor_json_writer_fragment(writer, save_chunks[i]->text, save_chunks[i]->len);
+            editor_json_writer_end_array(writer);
+        }
+
+        editor_json_writer_end_object(writer);
+    }
+
+    editor_json_writer_end_object(writer);
+}
+
+/*
+    Written to a temp file next to the scene and renamed over it, a crash
+    or a full disk mid save leaves the old scene intact
+*/
+static int serialize_save_thread(void *data){
+    (void)data;
+
+    char tmp_path[1100];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", save_path);
+
+    save_ok = false;
+    save_binary_ok = false;
+    save_binary_error[0] = '\0';
+    SDL_IOStream *io = SDL_IOFromFile(tmp_path, "wb");
+    if(io){
+        struct editor_json_writer writer;
+        editor_json_writer_init(&writer, io, 0);
+        serialize_write_document(&writer);
+
+        bool written = editor_json_writer_finish(&writer);
+        written = SDL_CloseIO(io) && written;
+        save_ok = written && SDL_RenamePath(tmp_path, save_path);
+    }
+
+    if(!save_ok)
+        SDL_RemovePath(tmp_path);
+    else
+        ye_set_fs_times(save_path, time(NULL), time(NULL));
+
+    // the copy is made from what just landed on disk, so it always matches the JSON
+    if(save_ok && save_binary){
+        char binary_path[1100];
+        editor_scene_binary_path(save_path, binary_path, sizeof(binary_path));
+        save_binary_ok = editor_scene_binary_from_json(save_path, binary_path, save_binary_error, sizeof(save_binary_error));
+    }
+
+    SDL_SetAtomicInt(&save_finished, 1);
+    return 0;
+}
+
+// joins the worker (blocking if it still runs), main thread only
+static void serialize_save_reap(){
+    if(save_thread){
+        SDL_WaitThread(save_thread, NULL);
+        save_thread = NULL;
+    }
+    json_decref(save_doc);
+    save_doc = NULL;
+    for(int i = 0; i < save_num_chunks; i++)
+        serialize_chunk_release(save_chunks[i]);
+    free(save_chunks);
+    save_chunks = NULL;
+    saving = false;
+
+    if(!save_ok){
+        // nothing reached the disk, the changes are still unsaved
+        unsaved = true;
+        ye_logf(error, "Failed to write the scene to %s\n", save_path);
+        return;
+    }
+
+    // our own write must not count as an outside change
+    SDL_PathInfo info;
+    if(strcmp(serialize_scene_path, save_path) == 0)
+        serialize_scene_mtime = SDL_GetPathInfo(save_path, &info) ? info.modify_time : 0;
+
+    ye_logf(debug, "Saved %d entities (%d re-serialized) in %.1fms.\n", save_num_chunks, save_num_serialized, (SDL_GetTicksNS() - save_start_ticks) / 1e6);
+
+    if(save_binary && !save_binary_ok)
+        ye_logf(error, "Failed to write the binary scene copy: %s\n", save_binary_error);
+}
+
+// starts the folded follow-up save, if one was requested
+static void serialize_save_start_queued(){
+    if(!save_queued)
+        return;
+
+    save_queued = false;
+    editor_write_scene_to_disk(save_queued_path);
+}
+
+void editor_serialize_poll(){
+    if(!save_thread || !SDL_GetAtomicInt(&save_finished))
+        return;
+
+    serialize_save_reap();
+    serialize_save_start_queued();
+}
+
+void editor_serialize_wait(){
+    while(save_thread){
+        serialize_save_reap();
+        serialize_save_start_queued();
+    }
 }
 
 void editor_write_scene_to_disk(const char *path){
+    if(save_thread){
+        // the running save has a snapshot from before these changes
+        save_queued = true;
+        snprintf(save_queued_path, sizeof(save_queued_path), "%s", path);
+        return;
+    }
+
     ye_logf(info,"Writing scene to disk at %s\n", path);
+    Uint64 start_ticks = SDL_GetTicksNS();
+
+    // ye_path_resources hands out a static buffer
+    char scene_path[1024];
+    snprintf(scene_path, sizeof(scene_path), "%s", ye_path_resources(YE_STATE.runtime.scene_file_path));
+
     // load the scene file into a json_t
-    json_t *scene = ye_json_read(ye_path_resources(YE_STATE.runtime.scene_file_path));
+    json_t *scene = serialize_load_scene(scene_path);
+    if(!scene){
+        ye_logf(error, "Failed to read %s, the scene was not saved.\n", scene_path);
+        return;
+    }
 
-    // create a json_t array listing all entities in the scene
-    json_t *entities = json_array();
-    // for(int i = 0; i < YE_STATE.runtime.entity_count; i++){
-    //     json_array_append_new(entities, json_string("meow!"));
-    // }
+    // the inspector and the viewport edit the selection, it is never trusted from the cache
+    for(struct editor_selection_node *itr = editor_selections; itr != NULL; itr = itr->next)
+        editor_serialize_mark_dirty(itr->ent);
+
+    size_t num_entities = 0;
+    for(struct ye_entity_node *node = entity_list_head; node != NULL; node = node->next)
+        num_entities++;
+
+    // the next table holds exactly the entities written now, at most half full
+    size_t capacity = 64;
+    while(capacity < num_entities * 2)
+        capacity *= 2;
+    struct serialize_cache_entry *next_cache = calloc(capacity, sizeof(struct serialize_cache_entry));
+
+    // the snapshot the worker writes, in entity list order
+    struct serialize_chunk **chunks = malloc((num_entities + 1) * sizeof(struct serialize_chunk *));
+    if(!chunks){
+        free(next_cache);
+        ye_logf(error, "Out of memory, the scene was not saved.\n");
+        return;
+    }
+    int num_chunks = 0;
+    int num_serialized = 0;
 
-    // lets traverse the entity list and write each entity to the json_t array
+    // lets traverse the entity list and collect the text of each entity
     struct ye_entity_node *node = entity_list_head;
     while(node != NULL){
         struct ye_entity *entity = node->entity;
@@ -342,60 +798,79 @@ void editor_write_scene_to_disk(const char *path){
             continue;
         }
 
-        json_t *entity_json = json_object();
-
-        // set the name
-        json_object_set_new(entity_json, "name", json_string(entity->name));
-
-        // set the active status
-        json_object_set_new(entity_json, "active", json_boolean(entity->active));
-
-        // create the components object
-        json_object_set_new(entity_json, "components", json_object());
-
-        if(entity->transform != NULL){
-            serialize_entity_transform(entity, json_object_get(entity_json, "components"));
-        }
-
-        if(entity->camera != NULL){
-            serialize_entity_camera(entity, json_object_get(entity_json, "components"));
+        void *components[SERIALIZE_CACHE_COMPONENTS];
+        serialize_cache_components(entity, components);
+
+        // reuse the text from the last save if nothing about the entity changed
+        struct serialize_chunk *chunk = NULL;
+        if(serialize_cache){
+            struct serialize_cache_entry *cached = serialize_cache_slot(serialize_cache, serialize_cache_capacity, entity);
+            if(cached->entity && cached->chunk && memcmp(cached->components, components, sizeof(components)) == 0){
+                chunk = cached->chunk;
+                cached->chunk = NULL; // the reference moves to the new table
+            }
         }
-
-        if(entity->renderer != NULL){
-            serialize_entity_renderer(entity, json_object_get(entity_json, "components"));
+        if(!chunk){
+            chunk = serialize_chunk_create(entity);
+            num_serialized++;
         }
-
-        if(entity->rigidbody != NULL){
-            serialize_entity_rigidbody(entity, json_object_get(entity_json, "components"));
+        if(!chunk){
+            ye_logf(error, "Failed to serialize entity %s, the scene was not saved.\n", entity->name);
+            for(int i = 0; i < num_chunks; i++)
+                serialize_chunk_release(chunks[i]);
+            free(chunks);
+            if(next_cache)
+                serialize_cache_free(next_cache, capacity);
+            return;
         }
 
-        if(entity->tag != NULL){
-            serialize_entity_tag(entity, json_object_get(entity_json, "components"));
-        }
+        // one reference for the worker
+        chunk->refs++;
+        chunks[num_chunks++] = chunk;
 
-        if(entity->audiosource != NULL){
-            serialize_entity_audiosource(entity, json_object_get(entity_json, "components"));
+        if(next_cache){
+            struct serialize_cache_entry *slot = serialize_cache_slot(next_cache, capacity, entity);
+            slot->entity = entity;
+            slot->chunk = chunk;
+            memcpy(slot->components, components, sizeof(components));
         }
-
-        if(entity->button != NULL){
-            serialize_entity_button(entity, json_object_get(entity_json, "components"));
+        else{
+            serialize_chunk_release(chunk);
         }
 
-        // add the entity to the entity json array
-        json_array_append_new(entities, entity_json);
-
         node = node->next;
     }
 
-    // update the scene file with the new entity list
-    json_object_set_new(json_object_get(scene, "scene"), "entities", entities);
+    if(serialize_cache)
+        serialize_cache_free(serialize_cache, serialize_cache_capacity);
+    serialize_cache = next_cache;
+    serialize_cache_capacity = next_cache ? capacity : 0;
 
-    // ye_json_log(scene); //TODO: figure out how we update the name version styles and prefabs
+    // make sure there is an entity list for the chunks to go in
+    json_t *scene_obj = json_object_get(scene, "scene");
+    if(json_is_object(scene_obj) && !json_object_get(scene_obj, "entities"))
+        json_object_set_new(scene_obj, "entities", json_array());
 
-    // write the scene file
-    ye_json_write(ye_path_resources(YE_STATE.runtime.scene_file_path), scene);           
+    // ye_json_log(scene); //TODO: figure out how we update the name version styles and prefabs
 
-    if(ye_set_fs_times(ye_path_resources(YE_STATE.runtime.scene_file_path), time(NULL), time(NULL)) != 0){
-        ye_logf(error, "failed to update file access time for %s\n", ye_path_resources(YE_STATE.runtime.scene_file_path));
+    // edits from here on are not part of this save
+    unsaved = false;
+    editor_saving();
+
+    json_incref(scene);
+    save_doc = scene;
+    save_chunks = chunks;
+    save_num_chunks = num_chunks;
+    snprintf(save_path, sizeof(save_path), "%s", scene_path);
+    save_start_ticks = start_ticks;
+    save_num_serialized = num_serialized;
+    save_binary = json_is_true(json_object_get(SETTINGS, "binary_scenes"));
+
+    SDL_SetAtomicInt(&save_finished, 0);
+    save_thread = SDL_CreateThread(serialize_save_thread, "SaveThread", NULL);
+    if(!save_thread){
+        ye_logf(warning, "Failed to create the save thread (%s), saving on the main thread.\n", SDL_GetError());
+        serialize_save_thread(NULL);
+        serialize_save_reap();
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,426 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include <jansson.h>
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor_size_report.h"
+
+struct editor_size_report editor_size_report;
+
+static SDL_Mutex *size_report_mutex = NULL;
+
+static const char *size_kind_names[EDITOR_SIZE_NUM_KINDS] = {"file", "section", "symbols", "directory", "type"};
+
+void editor_size_report_lock(){
+    SDL_LockMutex(size_report_mutex);
+}
+
+void editor_size_report_unlock(){
+    SDL_UnlockMutex(size_report_mutex);
+}
+
+/*
+    Entry list being built by one generate call
+*/
+struct size_list {
+    struct editor_size_entry *entries;
+    int count;
+    int capacity;
+};
+
+static struct editor_size_entry * size_list_find(struct size_list *list, enum editor_size_kind kind, const char *group, const char *name){
+    for(int i = 0; i < list->count; i++){
+        struct editor_size_entry *entry = &list->entries[i];
+        if(entry->kind == kind && strcmp(entry->group, group) == 0 && strcmp(entry->name, name) == 0)
+            return entry;
+    }
+    return NULL;
+}
+
+// adds bytes to the entry, creating it on first use
+static void size_list_add(struct size_list *list, enum editor_size_kind kind, const char *group, const char *name, Sint64 bytes){
+    struct editor_size_entry *entry = size_list_find(list, kind, group, name);
+    if(entry){
+        entry->bytes += bytes;
+        return;
+    }
+
+    if(list->count == list->capacity){
+        int capacity = list->capacity ? list->capacity * 2 : 64;
+        struct editor_size_entry *grown = realloc(list->entries, capacity * sizeof(struct editor_size_entry));
+        if(!grown)
+            return;
+        list->entries = grown;
+        list->capacity = capacity;
+    }
+
+    entry = &list->entries[list->count++];
+    memset(entry, 0, sizeof(*entry));
+    entry->kind = kind;
+    snprintf(entry->group, sizeof(entry->group), "%s", group);
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->bytes = bytes;
+    entry->previous = -1;
+}
+
+/*
+    Executable formats, read straight from the file so no binutils are needed
+*/
+
+static Uint64 size_read_le(const Uint8 *data, size_t size, size_t offset, int bytes){
+    if(offset + bytes > size)
+        return 0;
+    Uint64 value = 0;
+    for(int i = bytes - 1; i >= 0; i--)
+        value = (value << 8) | data[offset + i];
+    return value;
+}
+
+// "ye_", "SDL_", "lua_", ... or "(other)" for names without such a prefix
+static void size_symbol_group(const char *name, char *out, size_t size){
+    if(name[0] == '_' && name[1] == 'Z'){
+        snprintf(out, size, "(c++)");
+        return;
+    }
+
+    const char *underscore = strchr(name, '_');
+    int len = underscore ? (int)(underscore - name) : 0;
+    if(len < 1 || len > 8 || !SDL_isalpha((unsigned char)name[0])){
+        snprintf(out, size, "(other)");
+        return;
+    }
+    snprintf(out, size, "%.*s_", len, name);
+}
+
+static void size_measure_elf(struct size_list *list, const Uint8 *data, size_t size){
+    bool is64 = data[4] == 2;
+    if(data[5] != 1)
+        return; // big endian, none of our targets
+
+    Uint64 shoff = is64 ? size_read_le(data, size, 0x28, 8) : size_read_le(data, size, 0x20, 4);
+    Uint64 shentsize = size_read_le(data, size, is64 ? 0x3A : 0x2E, 2);
+    Uint64 shnum = size_read_le(data, size, is64 ? 0x3C : 0x30, 2);
+    Uint64 shstrndx = size_read_le(data, size, is64 ? 0x3E : 0x32, 2);
+    if(shoff == 0 || shentsize == 0 || shoff + shentsize * shnum > size || shstrndx >= shnum)
+        return;
+
+    #define SH(i, off64, off32, bytes64, bytes32) size_read_le(data, size, shoff + (i) * shentsize + (is64 ? (off64) : (off32)), is64 ? (bytes64) : (bytes32))
+    Uint64 shstr_offset = SH(shstrndx, 24, 16, 8, 4);
+    Uint64 shstr_size = SH(shstrndx, 32, 20, 8, 4);
+    if(shstr_offset + shstr_size > size)
+        return;
+
+    struct size_list groups = {0};
+    Uint64 symtab = 0;
+    bool has_symtab = false;
+
+    for(Uint64 i = 1; i < shnum; i++){
+        Uint64 name_offset = SH(i, 0, 0, 4, 4);
+        Uint64 type = SH(i, 4, 4, 4, 4);
+        Uint64 sh_size = SH(i, 32, 20, 8, 4);
+        if(type == 0 || sh_size == 0 || name_offset >= shstr_size)
+            continue;
+
+        const char *name = (const char *)data + shstr_offset + name_offset;
+        if(!memchr(name, '\0', shstr_size - name_offset))
+            continue;
+
+        // dozens of debug sections, one line is enough to see what stripping would save
+        if(strncmp(name, ".debug", 6) == 0)
+            name = ".debug*";
+        size_list_add(list, EDITOR_SIZE_SECTION, "game", name, (Sint64)sh_size);
+
+        if(type == 2){ // SHT_SYMTAB
+            symtab = i;
+            has_symtab = true;
+        }
+    }
+
+    /*
+        Function and object symbols by name prefix. Stripped builds have
+        no symbol table and only get the section breakdown
+    */
+    if(has_symtab){
+        Uint64 sym_offset = SH(symtab, 24, 16, 8, 4);
+        Uint64 sym_size = SH(symtab, 32, 20, 8, 4);
+        Uint64 strtab = SH(symtab, 40, 24, 4, 4);
+        Uint64 str_offset = strtab < shnum ? SH(strtab, 24, 16, 8, 4) : 0;
+        Uint64 str_size = strtab < shnum ? SH(strtab, 32, 20, 8, 4) : 0;
+        Uint64 entsize = is64 ? 24 : 16;
+
+        if(sym_offset + sym_size <= size && str_offset + str_size <= size){
+            for(Uint64 s = sym_offset; s + entsize <= sym_offset + sym_size; s += entsize){
+                Uint64 name_offset = size_read_le(data, size, s, 4);
+                Uint8 info = data[s + (is64 ? 4 : 12)];
+                Uint64 sym_bytes = is64 ? size_read_le(data, size, s + 16, 8) : size_read_le(data, size, s + 8, 4);
+                int type = info & 0xf;
+                if((type != 1 && type != 2) || sym_bytes == 0 || name_offset >= str_size)
+                    continue; // only STT_OBJECT and STT_FUNC take up space
+
+                const char *name = (const char *)data + str_offset + name_offset;
+                if(!memchr(name, '\0', str_size - name_offset))
+                    continue;
+
+                char group[32];
+                size_symbol_group(name, group, sizeof(group));
+                size_list_add(&groups, EDITOR_SIZE_SYMBOLS, "game", group, (Sint64)sym_bytes);
+            }
+        }
+    }
+    #undef SH
+
+    // the biggest groups as they are, everything else lumped together
+    for(int i = 0; i < groups.count; i++){
+        int larger = 0;
+        for(int j = 0; j < groups.count; j++){
+            if(groups.entries[j].bytes > groups.entries[i].bytes || (groups.entries[j].bytes == groups.entries[i].bytes && j < i))
+                larger++;
+        }
+        const char *name = larger < EDITOR_SIZE_MAX_SYMBOL_GROUPS ? groups.entries[i].name : "(other)";
+        size_list_add(list, EDITOR_SIZE_SYMBOLS, "game", name, groups.entries[i].bytes);
+    }
+    free(groups.entries);
+}
+
+static void size_measure_pe(struct size_list *list, const Uint8 *data, size_t size){
+    Uint64 pe = size_read_le(data, size, 0x3C, 4);
+    if(pe + 24 > size || memcmp(data + pe, "PE\0\0", 4) != 0)
+        return;
+
+    Uint64 coff = pe + 4;
+    Uint64 num_sections = size_read_le(data, size, coff + 2, 2);
+    Uint64 optional_size = size_read_le(data, size, coff + 16, 2);
+    Uint64 table = coff + 20 + optional_size;
+
+    for(Uint64 i = 0; i < num_sections && table + (i + 1) * 40 <= size; i++){
+        const Uint8 *section = data + table + i * 40;
+        char name[9];
+        memcpy(name, section, 8);
+        name[8] = '\0';
+
+        // raw size is what is on disk, uninitialized data only has a virtual size
+        Uint64 bytes = size_read_le(data, size, table + i * 40 + 16, 4);
+        if(bytes == 0)
+            bytes = size_read_le(data, size, table + i * 40 + 8, 4);
+        if(bytes > 0)
+            size_list_add(list, EDITOR_SIZE_SECTION, "game", name, (Sint64)bytes);
+    }
+}
+
+static Sint64 size_file_bytes(const char *path){
+    SDL_PathInfo info;
+    if(!SDL_GetPathInfo(path, &info) || info.type != SDL_PATHTYPE_FILE)
+        return -1;
+    return info.size;
+}
+
+static void size_measure_executable(struct size_list *list, const char *exe_path){
+    Sint64 bytes = size_file_bytes(exe_path);
+    if(bytes < 0)
+        return;
+    size_list_add(list, EDITOR_SIZE_FILE, "files", "game", bytes);
+
+    size_t size = 0;
+    Uint8 *data = SDL_LoadFile(exe_path, &size);
+    if(!data)
+        return;
+
+    if(size > 64 && memcmp(data, "\x7f" "ELF", 4) == 0)
+        size_measure_elf(list, data, size);
+    else if(size > 64 && data[0] == 'M' && data[1] == 'Z')
+        size_measure_pe(list, data, size);
+
+    SDL_free(data);
+}
+
+/*
+    Packs, by what their manifest says went into them
+*/
+static void size_measure_pack(struct size_list *list, const char *project_root, const char *pack){
+    // packs sit in the project root, their manifests in build/
+    char path[1200];
+    snprintf(path, sizeof(path), "%s/%s", project_root, pack);
+    Sint64 bytes = size_file_bytes(path);
+    if(bytes < 0)
+        return; // not packed yet
+    size_list_add(list, EDITOR_SIZE_FILE, "files", pack, bytes);
+
+    snprintf(path, sizeof(path), "%s/build/%s.manifest", project_root, pack);
+    json_t *manifest = json_load_file(path, 0, NULL);
+    if(!manifest)
+        return;
+
+    const char *file;
+    json_t *entry;
+    json_object_foreach(json_object_get(manifest, "files"), file, entry){
+        Sint64 file_bytes = json_integer_value(json_object_get(entry, "size"));
+
+        char dir[128];
+        const char *slash = strchr(file, '/');
+        if(slash)
+            snprintf(dir, sizeof(dir), "%.*s/", (int)(slash - file), file);
+        else
+            snprintf(dir, sizeof(dir), "(top level)");
+        size_list_add(list, EDITOR_SIZE_DIRECTORY, pack, dir, file_bytes);
+
+        char type[32];
+        const char *base = strrchr(file, '/');
+        base = base ? base + 1 : file;
+        const char *dot = strrchr(base, '.');
+        if(dot && dot != base && dot[1]){
+            snprintf(type, sizeof(type), "%s", dot);
+            for(char *c = type; *c; c++)
+                *c = SDL_tolower((unsigned char)*c);
+        }
+        else{
+            snprintf(type, sizeof(type), "(none)");
+        }
+        size_list_add(list, EDITOR_SIZE_TYPE, pack, type, file_bytes);
+    }
+    json_decref(manifest);
+}
+
+/*
+    Report persistence and diffing
+*/
+
+static int size_entry_compare(const void *a, const void *b){
+    const struct editor_size_entry *ea = (const struct editor_size_entry *)a;
+    const struct editor_size_entry *eb = (const struct editor_size_entry *)b;
+    if(ea->kind != eb->kind)
+        return (int)ea->kind - (int)eb->kind;
+    int group = strcmp(ea->group, eb->group);
+    if(group != 0)
+        return group;
+    Sint64 sa = ea->bytes > 0 ? ea->bytes : ea->previous;
+    Sint64 sb = eb->bytes > 0 ? eb->bytes : eb->previous;
+    if(sa != sb)
+        return sa < sb ? 1 : -1;
+    return strcmp(ea->name, eb->name);
+}
+
+static enum editor_size_kind size_kind_from_name(const char *name){
+    for(int i = 0; i < EDITOR_SIZE_NUM_KINDS; i++){
+        if(name && strcmp(name, size_kind_names[i]) == 0)
+            return (enum editor_size_kind)i;
+    }
+    return EDITOR_SIZE_NUM_KINDS;
+}
+
+static bool size_diff_previous(struct size_list *list, const char *report_path){
+    json_t *old = json_load_file(report_path, 0, NULL);
+    if(!old)
+        return false;
+
+    int current = list->count;
+    size_t index;
+    json_t *value;
+    json_array_foreach(json_object_get(old, "entries"), index, value){
+        enum editor_size_kind kind = size_kind_from_name(json_string_value(json_object_get(value, "kind")));
+        const char *group = json_string_value(json_object_get(value, "group"));
+        const char *name = json_string_value(json_object_get(value, "name"));
+        if(kind == EDITOR_SIZE_NUM_KINDS || !group || !name)
+            continue;
+
+        Sint64 bytes = json_integer_value(json_object_get(value, "bytes"));
+        struct editor_size_entry *entry = size_list_find(list, kind, group, name);
+        if(entry && entry - list->entries < current){
+            entry->previous = bytes;
+        }
+        else if(!entry){
+            // gone since the previous build, still listed so the saving shows up
+            size_list_add(list, kind, group, name, 0);
+            list->entries[list->count - 1].previous = bytes;
+        }
+    }
+    json_decref(old);
+    return true;
+}
+
+static void size_save(struct size_list *list, const char *report_path, Sint64 timestamp){
+    json_t *entries = json_array();
+    for(int i = 0; i < list->count; i++){
+        struct editor_size_entry *entry = &list->entries[i];
+        if(entry->bytes == 0)
+            continue;
+
+        json_t *value = json_object();
+        json_object_set_new(value, "kind", json_string(size_kind_names[entry->kind]));
+        json_object_set_new(value, "group", json_string(entry->group));
+        json_object_set_new(value, "name", json_string(entry->name));
+        json_object_set_new(value, "bytes", json_integer(entry->bytes));
+        json_array_append_new(entries, value);
+    }
+
+    json_t *report = json_object();
+    json_object_set_new(report, "timestamp", json_integer(timestamp));
+    json_object_set_new(report, "entries", entries);
+    json_dump_file(report, report_path, JSON_INDENT(4));
+    json_decref(report);
+}
+
+bool editor_size_report_generate(const char *exe_path, const char *build_dir, const char *project_root){
+    struct size_list list = {0};
+    size_measure_executable(&list, exe_path);
+    size_measure_pack(&list, project_root, "engine.yep");
+    size_measure_pack(&list, project_root, "resources.yep");
+    if(list.count == 0)
+        return false;
+
+    char report_path[1200];
+    snprintf(report_path, sizeof(report_path), "%s/%s", build_dir, EDITOR_SIZE_REPORT_FILE);
+    bool has_previous = size_diff_previous(&list, report_path);
+
+    SDL_Time now = 0;
+    SDL_GetCurrentTime(&now);
+    Sint64 timestamp = now / SDL_NS_PER_SECOND;
+    size_save(&list, report_path, timestamp);
+
+    qsort(list.entries, list.count, sizeof(struct editor_size_entry), size_entry_compare);
+
+    const char *name = strrchr(build_dir, '/');
+
+    editor_size_report_lock();
+    free(editor_size_report.entries);
+    editor_size_report.valid = true;
+    editor_size_report.has_previous = has_previous;
+    editor_size_report.timestamp = timestamp;
+    snprintf(editor_size_report.config, sizeof(editor_size_report.config), "%s", name ? name + 1 : build_dir);
+    editor_size_report.entries = list.entries;
+    editor_size_report.num_entries = list.count;
+    editor_size_report_unlock();
+    return true;
+}
+
+bool editor_size_report_file(const char *group, Sint64 *bytes, Sint64 *previous){
+    for(int i = 0; i < editor_size_report.num_entries; i++){
+        struct editor_size_entry *entry = &editor_size_report.entries[i];
+        if(entry->kind == EDITOR_SIZE_FILE && strcmp(entry->name, group) == 0){
+            *bytes = entry->bytes;
+            *previous = entry->previous;
+            return true;
+        }
+    }
+    return false;
+}
+
+void editor_size_report_init(){
+    size_report_mutex = SDL_CreateMutex();
+}
+
+void editor_size_report_shutdown(){
+    free(editor_size_report.entries);
+    memset(&editor_size_report, 0, sizeof(editor_size_report));
+    SDL_DestroyMutex(size_report_mutex);
+    size_report_mutex = NULL;
+}
@@ -7,9 +7,18 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdbool.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
 
 #include <yoyoengine/yoyoengine.h>
 
+#include "editor_utils.h"
+
 void editor_open_in_system(const char *url_or_file_path) {
     char command[512];
 
@@ -40,3 +49,125 @@ bool editor_update_window_title(const char *format, ...) {
         return false;
     }
 }
+
+Uint64 editor_hash(Uint64 hash, const void *data, size_t len) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for(size_t i = 0; i < len; i++){
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+long editor_available_memory_mb() {
+    #ifdef _WIN32
+        MEMORYSTATUSEX status;
+        status.dwLength = sizeof(status);
+        if(!GlobalMemoryStatusEx(&status))
+            return -1;
+        return (long)(status.ullAvailPhys / (1024 * 1024));
+    #elif defined(__linux__)
+        // MemAvailable accounts for reclaimable page cache, MemFree would badly undercount
+        FILE *meminfo = fopen("/proc/meminfo", "r");
+        if(!meminfo)
+            return -1;
+
+        long available_kb = -1;
+        char line[256];
+        while(fgets(line, sizeof(line), meminfo)){
+            if(sscanf(line, "MemAvailable: %ld kB", &available_kb) == 1)
+                break;
+        }
+        fclose(meminfo);
+        return available_kb < 0 ? -1 : available_kb / 1024;
+    #else
+        return -1;
+    #endif
+}
+
+/*
+    Recursive directory copy/removal, on top of SDL's filesystem API
+*/
+struct editor_copy_walk {
+    const char *src;
+    const char *dst;
+    bool ok;
+};
+
+static SDL_EnumerationResult SDLCALL editor_copy_cb(void *userdata, const char *dirname, const char *fname) {
+    struct editor_copy_walk *walk = (struct editor_copy_walk *)userdata;
+
+    char from[1024];
+    char to[1024];
+    snprintf(from, sizeof(from), "%s%s", dirname, fname);
+    snprintf(to, sizeof(to), "%s/%s", walk->dst, fname);
+
+    SDL_PathInfo info;
+    if(!SDL_GetPathInfo(from, &info)){
+        walk->ok = false;
+        return SDL_ENUM_FAILURE;
+    }
+
+    if(info.type == SDL_PATHTYPE_DIRECTORY)
+        walk->ok = editor_copy_directory(from, to);
+    else if(info.type == SDL_PATHTYPE_FILE)
+        walk->ok = SDL_CopyFile(from, to);
+
+    return walk->ok ? SDL_ENUM_CONTINUE : SDL_ENUM_FAILURE;
+}
+
+bool editor_copy_directory(const char *src, const char *dst) {
+    if(!SDL_CreateDirectory(dst))
+        return false;
+
+    struct editor_copy_walk walk = {src, dst, true};
+    return SDL_EnumerateDirectory(src, editor_copy_cb, &walk) && walk.ok;
+}
+
+static SDL_EnumerationResult SDLCALL editor_remove_cb(void *userdata, const char *dirname, const char *fname) {
+    (void)userdata;
+
+    char path[1024];
+    snprintf(path, sizeof(path), "%s%s", dirname, fname);
+
+    SDL_PathInfo info;
+    if(SDL_GetPathInfo(path, &info) && info.type == SDL_PATHTYPE_DIRECTORY)
+        editor_remove_directory(path);
+    else
+        SDL_RemovePath(path);
+
+    return SDL_ENUM_CONTINUE;
+}
+
+void editor_remove_directory(const char *path) {
+    SDL_EnumerateDirectory(path, editor_remove_cb, NULL);
+    SDL_RemovePath(path);
+}
+
+bool editor_link_or_copy(const char *src, const char *dst) {
+    #ifdef _WIN32
+        if(CreateHardLinkA(dst, src, NULL))
+            return true;
+    #else
+        if(link(src, dst) == 0)
+            return true;
+    #endif
+
+    // different filesystem (or no hard link support), fall back to a real copy
+    return SDL_CopyFile(src, dst);
+}
+
+void editor_format_bytes(Sint64 bytes, bool sign, char *out, size_t size) {
+    const char *plus = sign && bytes > 0 ? "+" : "";
+    double value = (double)bytes;
+    double magnitude = value < 0 ? -value : value;
+
+    if(magnitude < 1024)
+        snprintf(out, size, "%s%lld B", plus, (long long)bytes);
+    else if(magnitude < 1024.0 * 1024)
+        snprintf(out, size, "%s%.1f KiB", plus, value / 1024);
+    else if(magnitude < 1024.0 * 1024 * 1024)
+        snprintf(out, size, "%s%.2f MiB", plus, value / (1024.0 * 1024));
+    else
+        snprintf(out, size, "%s%.2f GiB", plus, value / (1024.0 * 1024 * 1024));
+}
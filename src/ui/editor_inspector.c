@@ -140,6 +140,7 @@ static void SDLCALL editor_browse_renderer_image_cb(void* userdata, const char*
     }
     // recomputes the image texture
     ye_update_renderer_component(ent);
+    editor_serialize_mark_dirty(ent);
     editor_unsaved();
     
     (void)userdata; // unused
@@ -1004,6 +1005,7 @@ static void SDLCALL editor_browse_audio_ret(void* userdata, const char* const* f
     for (char *p = ent->audiosource->handle; *p; p++) {
         if (*p == '\\') *p = '/';
     }
+    editor_serialize_mark_dirty(ent);
     editor_unsaved();
     
     (void)filter; // unused
@@ -1239,6 +1241,7 @@ void ye_editor_paint_inspector(struct nk_context *ctx){
                     struct editor_selection_node *current = editor_selections;
 
                     while(current != NULL){
+                        editor_serialize_mark_dirty(current->ent);
                         ye_destroy_entity(current->ent);
                         current = current->next;
                     }
@@ -1261,6 +1264,7 @@ void ye_editor_paint_inspector(struct nk_context *ctx){
                     while(cur != NULL) {
                         struct editor_selection_node *new_node = malloc(sizeof(struct editor_selection_node));
                         new_node->ent = ye_duplicate_entity(cur->ent);
+                        editor_serialize_mark_dirty(new_node->ent);
                         new_node->next = new;
                         new_selections++;
 
@@ -8,8 +8,11 @@
 #include "editor.h"
 #include "editor_ui.h"
 #include "editor_build.h"
+#include "editor_pack.h"
+#include "editor_batch.h"
 #include "editor_panels.h"
 #include "editor_utils.h"
+#include "editor_size_report.h"
 #include <yoyoengine/yoyoengine.h>
 
 /*
@@ -56,15 +59,21 @@ bool frustum_sleeping;
 */
 char build_additional_cflags[128];
 char build_platform[32];
-int original_build_platform_int; // tracks the target platform when opening settings, to compare with after closing if we need to set the "delete_cache" build.yoyo bool
 int build_platform_int;
 int build_mode_int;
 char build_engine_tag_name[256];
 char build_rc_path[256];
-bool original_use_local_engine;
 bool use_local_engine;
 char local_engine_path[512];
 char build_executable_path[512];
+bool build_unity;
+bool build_pch;
+bool build_profiling;
+int build_compiler_cache_int; // 0-3 (none, ccache, sccache, auto)
+char build_compiler_cache_size[32];
+int build_max_jobs; // 0 = pick from cores and free memory
+int build_optimization_int; // 0-2 (none, lto, pgo)
+int build_pgo_seconds;
 
 /*
     Helper functions
@@ -425,6 +434,80 @@ void ye_editor_paint_project_settings(struct nk_context *ctx){
             static const char *build_modes[] = {"Debug", "Release"};
             nk_combobox(ctx, build_modes, NK_LEN(build_modes), &build_mode_int, 25, nk_vec2(200,200));
 
+            /*
+                Release optimization (LTO, PGO)
+            */
+            if(build_mode_int == 1){
+                nk_layout_row_dynamic(ctx, 25, 2);
+                bounds = nk_widget_bounds(ctx);
+                nk_label(ctx, "Optimization:", NK_TEXT_LEFT);
+                if (nk_input_is_mouse_hovering_rect(in, bounds))
+                    nk_tooltip(ctx, "LTO optimizes across files at link time. PGO also builds an instrumented game, runs it to record a profile and rebuilds optimized with it. PGO needs GCC and a build for this machine, otherwise it falls back to LTO.");
+                static const char *optimizations[] = {"None", "LTO", "PGO + LTO"};
+                nk_combobox(ctx, optimizations, NK_LEN(optimizations), &build_optimization_int, 25, nk_vec2(200,200));
+
+                if(build_optimization_int == 2){
+                    nk_layout_row_dynamic(ctx, 25, 2);
+                    bounds = nk_widget_bounds(ctx);
+                    nk_label(ctx, "Training Seconds:", NK_TEXT_LEFT);
+                    if (nk_input_is_mouse_hovering_rect(in, bounds))
+                        nk_tooltip(ctx, "How long the profiling run lasts before the game is asked to quit.");
+                    nk_property_int(ctx, "#s", 1, &build_pgo_seconds, 3600, 1, 5);
+                }
+            }
+
+            /*
+                Compiler cache
+            */
+            nk_layout_row_dynamic(ctx, 25, 2);
+            bounds = nk_widget_bounds(ctx);
+            nk_label(ctx, "Compiler Cache:", NK_TEXT_LEFT);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, "Wraps the compiler with ccache or sccache (must be installed) so reconfigures and branch switches reuse earlier compiles. Auto uses whichever is installed when building against the shared engine source, so projects on the same engine version reuse each other's engine objects.");
+            static const char *compiler_caches[] = {"None", "ccache", "sccache", "Auto"};
+            nk_combobox(ctx, compiler_caches, NK_LEN(compiler_caches), &build_compiler_cache_int, 25, nk_vec2(200,200));
+
+            if(build_compiler_cache_int != 0){
+                nk_layout_row_dynamic(ctx, 25, 2);
+                bounds = nk_widget_bounds(ctx);
+                nk_label(ctx, "Cache Size Limit:", NK_TEXT_LEFT);
+                if (nk_input_is_mouse_hovering_rect(in, bounds))
+                    nk_tooltip(ctx, "Maximum cache size, e.g. 5G or 500M. Empty = the tool's default.");
+                nk_edit_string_zero_terminated(ctx, NK_EDIT_FIELD, build_compiler_cache_size, sizeof(build_compiler_cache_size), nk_filter_default);
+            }
+
+            /*
+                Build parallelism cap
+            */
+            nk_layout_row_dynamic(ctx, 25, 2);
+            bounds = nk_widget_bounds(ctx);
+            nk_label(ctx, "Max Build Jobs:", NK_TEXT_LEFT);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, "Upper limit on parallel compile jobs. 0 = pick from cores and free memory.");
+            nk_property_int(ctx, "#jobs", 0, &build_max_jobs, 256, 1, 1);
+
+            /*
+                Compile speedups for the game's own sources
+            */
+            nk_layout_row_dynamic(ctx, 25, 2);
+            bounds = nk_widget_bounds(ctx);
+            nk_checkbox_label(ctx, "Unity Build", (nk_bool*)&build_unity);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, "Compiles the game's C files in batches of 16 per translation unit. File level static names must not clash.");
+            bounds = nk_widget_bounds(ctx);
+            nk_checkbox_label(ctx, "Precompiled Header", (nk_bool*)&build_pch);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, "Parses yoyoengine/yoyoengine.h once per build instead of once per file.");
+
+            /*
+                Profiling build (gprof)
+            */
+            nk_layout_row_dynamic(ctx, 25, 1);
+            bounds = nk_widget_bounds(ctx);
+            nk_checkbox_label(ctx, "Profiling Build (gprof)", (nk_bool*)&build_profiling);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, "Compiles the game with -pg. Quit a run normally and its profile opens in the editor. Linux (GCC) only, replaces PGO with plain LTO.");
+
             /*
                 Executable path override
             */
@@ -433,7 +516,7 @@ void ye_editor_paint_project_settings(struct nk_context *ctx){
             bounds = nk_widget_bounds(ctx);
             nk_label(ctx, "Exe Path Override:", NK_TEXT_LEFT);
             if (nk_input_is_mouse_hovering_rect(in, bounds))
-                nk_tooltip(ctx, "Empty = default (build/<mode>/<name>). Set to exe path if CMakeLists outputs elsewhere.");
+                nk_tooltip(ctx, "Empty = default (build/<platform>-<mode>-<hash>/<mode>/<name>). Set to exe path if CMakeLists outputs elsewhere.");
             nk_layout_row_push(ctx, 0.43f);
             nk_edit_string_zero_terminated(ctx, NK_EDIT_FIELD, build_executable_path, 512, nk_filter_default);
             nk_layout_row_push(ctx, 0.05f);
@@ -556,10 +639,17 @@ void ye_editor_paint_project_settings(struct nk_context *ctx){
                 json_object_set_new(BUILD_FILE, "rc_path", json_string(build_rc_path));
                 json_object_set_new(BUILD_FILE, "platform", json_string(platforms[build_platform_int]));
                 json_object_set_new(BUILD_FILE, "core_tag", json_string(build_engine_tag_name));
-                json_object_set_new(BUILD_FILE, "delete_cache", json_boolean((original_build_platform_int != build_platform_int) || (original_use_local_engine != use_local_engine)));
                 json_object_set_new(BUILD_FILE, "use_local_engine", json_boolean(use_local_engine));
                 json_object_set_new(BUILD_FILE, "local_engine_path", json_string(local_engine_path));
                 json_object_set_new(BUILD_FILE, "executable_path", json_string(build_executable_path));
+                json_object_set_new(BUILD_FILE, "unity_build", json_boolean(build_unity));
+                json_object_set_new(BUILD_FILE, "precompiled_header", json_boolean(build_pch));
+                json_object_set_new(BUILD_FILE, "profiling", json_boolean(build_profiling));
+                json_object_set_new(BUILD_FILE, "compiler_cache", json_string(build_compiler_cache_int == 1 ? "ccache" : build_compiler_cache_int == 2 ? "sccache" : build_compiler_cache_int == 3 ? "auto" : "none"));
+                json_object_set_new(BUILD_FILE, "compiler_cache_max_size", json_string(build_compiler_cache_size));
+                json_object_set_new(BUILD_FILE, "max_jobs", json_integer(build_max_jobs));
+                json_object_set_new(BUILD_FILE, "optimization", json_string(build_optimization_int == 1 ? "lto" : build_optimization_int == 2 ? "pgo" : "none"));
+                json_object_set_new(BUILD_FILE, "pgo_seconds", json_integer(build_pgo_seconds));
                 ye_json_write(ye_path("build.yoyo"),BUILD_FILE);
 
                 editor_saved();
@@ -592,7 +682,8 @@ void ye_editor_paint_project(struct nk_context *ctx){
 
             bounds = nk_widget_bounds(ctx);
             if(nk_button_image(ctx, editor_icons.pack)){
-                editor_build_packs(true);
+                editor_batch_wait_project_packs(EDITOR_STATE.opened_project_path);
+                editor_pack_start(true);
             }
             if (nk_input_is_mouse_hovering_rect(in, bounds))
                 nk_tooltip(ctx, "Rebuild (FORCED) the yep packs");
@@ -625,6 +716,90 @@ void ye_editor_paint_project(struct nk_context *ctx){
             if (nk_input_is_mouse_hovering_rect(in, bounds))
                 nk_tooltip(ctx, "Run the project");
 
+            /*
+                Build time trend (successful builds only, failures end early and skew it)
+            */
+            editor_build_history_load();
+            int num_ok = 0;
+            float max_seconds = 1.0f;
+            for(int i = 0; i < editor_build_history_count; i++){
+                if(editor_build_history[i].result != 1)
+                    continue;
+                num_ok++;
+                if(editor_build_history[i].total > max_seconds)
+                    max_seconds = editor_build_history[i].total;
+            }
+            if(num_ok > 0){
+                struct editor_build_timing *last = NULL;
+                for(int i = editor_build_history_count - 1; i >= 0 && !last; i--){
+                    if(editor_build_history[i].result == 1)
+                        last = &editor_build_history[i];
+                }
+
+                char summary[256];
+                snprintf(summary, sizeof(summary), "Last build: %.1fs (pack %.1fs/%.1fs, configure %.1fs, compile %.1fs, launch %.1fs)",
+                    last->total, last->pack_engine, last->pack_resources, last->configure, last->compile, last->launch);
+                nk_layout_row_dynamic(ctx, 20, 1);
+                nk_label(ctx, summary, NK_TEXT_LEFT);
+
+                // what unity builds / the precompiled header bought, once both sides have a full build
+                float with_speedups, without_speedups;
+                if(editor_build_compile_delta(&with_speedups, &without_speedups) && without_speedups > 0){
+                    char delta[256];
+                    snprintf(delta, sizeof(delta), "Unity/PCH full compile: %.1fs vs %.1fs without (%+.0f%%)",
+                        with_speedups, without_speedups, 100.0f * (with_speedups - without_speedups) / without_speedups);
+                    nk_layout_row_dynamic(ctx, 20, 1);
+                    nk_label_colored(ctx, delta, NK_TEXT_LEFT, with_speedups <= without_speedups ? nk_rgb(0, 220, 120) : nk_rgb(255, 140, 0));
+                }
+
+                // what the last build ships, and how that moved
+                editor_size_report_lock();
+                char sizes[256] = "";
+                static const char *shipped[] = {"game", "engine.yep", "resources.yep"};
+                for(int i = 0; i < 3; i++){
+                    Sint64 bytes, previous;
+                    if(!editor_size_report_file(shipped[i], &bytes, &previous))
+                        continue;
+                    char size[32], delta[32] = "";
+                    editor_format_bytes(bytes, false, size, sizeof(size));
+                    if(editor_size_report.has_previous && previous >= 0 && previous != bytes){
+                        char change[24];
+                        editor_format_bytes(bytes - previous, true, change, sizeof(change));
+                        snprintf(delta, sizeof(delta), " (%s)", change);
+                    }
+                    size_t len = strlen(sizes);
+                    snprintf(sizes + len, sizeof(sizes) - len, "%s%s %s%s", len ? ", " : "Size: ", shipped[i], size, delta);
+                }
+                editor_size_report_unlock();
+                if(sizes[0]){
+                    nk_layout_row_dynamic(ctx, 20, 1);
+                    bounds = nk_widget_bounds(ctx);
+                    nk_label(ctx, sizes, NK_TEXT_LEFT);
+                    if (nk_input_is_mouse_hovering_rect(in, bounds))
+                        nk_tooltip(ctx, "Open Size Report under Additional Actions for the full breakdown");
+                }
+
+                nk_layout_row_dynamic(ctx, 60, 1);
+                bounds = nk_widget_bounds(ctx);
+                if(nk_chart_begin_colored(ctx, NK_CHART_LINES, nk_rgb(255, 255, 255), nk_rgb(255, 255, 255), num_ok, 0, max_seconds)){
+                    nk_chart_add_slot_colored(ctx, NK_CHART_LINES, nk_rgb(255, 140, 0), nk_rgb(255, 140, 0), num_ok, 0, max_seconds);
+                    nk_chart_add_slot_colored(ctx, NK_CHART_LINES, nk_rgb(0, 160, 255), nk_rgb(0, 160, 255), num_ok, 0, max_seconds);
+                    nk_chart_add_slot_colored(ctx, NK_CHART_LINES, nk_rgb(0, 220, 120), nk_rgb(0, 220, 120), num_ok, 0, max_seconds);
+                    for(int i = 0; i < editor_build_history_count; i++){
+                        struct editor_build_timing *timing = &editor_build_history[i];
+                        if(timing->result != 1)
+                            continue;
+                        nk_chart_push_slot(ctx, timing->total, 0);
+                        nk_chart_push_slot(ctx, timing->compile, 1);
+                        nk_chart_push_slot(ctx, timing->configure, 2);
+                        nk_chart_push_slot(ctx, timing->pack_engine > timing->pack_resources ? timing->pack_engine : timing->pack_resources, 3);
+                    }
+                    nk_chart_end(ctx);
+                }
+                if (nk_input_is_mouse_hovering_rect(in, bounds))
+                    nk_tooltip(ctx, "Build times of the last builds: white = total, orange = compile, blue = configure, green = packing");
+            }
+
             nk_layout_row_dynamic(ctx, 35, 1);
             nk_label_colored(ctx, "Additional Actions:", NK_TEXT_LEFT, nk_rgb(255, 255, 255));
             nk_layout_row_dynamic(ctx, 35, 2);
@@ -900,7 +1075,6 @@ void ye_editor_paint_project(struct nk_context *ctx){
                                 build_platform_int = 0;
                             }
                         }
-                        original_build_platform_int = build_platform_int;
                         strncpy(build_platform, (char*)tmp_build_platform, (size_t)sizeof(build_platform) - 1);
                         build_platform[(size_t)sizeof(build_platform) - 1] = '\0'; // null terminate just in case TODO: write helper?
 
@@ -910,7 +1084,6 @@ void ye_editor_paint_project(struct nk_context *ctx){
                         if(!ye_json_bool(BUILD_FILE, "use_local_engine", &use_local_engine)){
                             use_local_engine = false;
                         }
-                        original_use_local_engine = use_local_engine;
 
                         /*
                             Local engine path
@@ -932,6 +1105,64 @@ void ye_editor_paint_project(struct nk_context *ctx){
                             strncpy(build_executable_path, tmp_executable_path, sizeof(build_executable_path) - 1);
                             build_executable_path[sizeof(build_executable_path) - 1] = '\0';
                         }
+
+                        /*
+                            Unity build / precompiled header
+                        */
+                        if(!ye_json_bool(BUILD_FILE, "unity_build", &build_unity)){
+                            build_unity = false;
+                        }
+                        if(!ye_json_bool(BUILD_FILE, "precompiled_header", &build_pch)){
+                            build_pch = false;
+                        }
+
+                        /*
+                            Profiling build
+                        */
+                        if(!ye_json_bool(BUILD_FILE, "profiling", &build_profiling)){
+                            build_profiling = false;
+                        }
+
+                        /*
+                            Compiler cache
+                        */
+                        const char *tmp_compiler_cache;
+                        build_compiler_cache_int = 3; // older build.yoyo files have no key, they get auto
+                        if(ye_json_string(BUILD_FILE, "compiler_cache", &tmp_compiler_cache)){
+                            if(strcmp(tmp_compiler_cache, "none") == 0)
+                                build_compiler_cache_int = 0;
+                            else if(strcmp(tmp_compiler_cache, "ccache") == 0)
+                                build_compiler_cache_int = 1;
+                            else if(strcmp(tmp_compiler_cache, "sccache") == 0)
+                                build_compiler_cache_int = 2;
+                        }
+                        const char *tmp_compiler_cache_size;
+                        if(!ye_json_string(BUILD_FILE, "compiler_cache_max_size", &tmp_compiler_cache_size)){
+                            build_compiler_cache_size[0] = '\0';
+                        } else {
+                            strncpy(build_compiler_cache_size, tmp_compiler_cache_size, sizeof(build_compiler_cache_size) - 1);
+                            build_compiler_cache_size[sizeof(build_compiler_cache_size) - 1] = '\0';
+                        }
+
+                        /*
+                            Build jobs cap
+                        */
+                        build_max_jobs = (int)json_integer_value(json_object_get(BUILD_FILE, "max_jobs"));
+
+                        /*
+                            Optimization
+                        */
+                        const char *tmp_optimization;
+                        build_optimization_int = 0;
+                        if(ye_json_string(BUILD_FILE, "optimization", &tmp_optimization)){
+                            if(strcmp(tmp_optimization, "lto") == 0)
+                                build_optimization_int = 1;
+                            else if(strcmp(tmp_optimization, "pgo") == 0)
+                                build_optimization_int = 2;
+                        }
+                        build_pgo_seconds = (int)json_integer_value(json_object_get(BUILD_FILE, "pgo_seconds"));
+                        if(build_pgo_seconds <= 0)
+                            build_pgo_seconds = 30;
                     }
                     else{
                         ye_logf(error, "build.yoyo not found.");
@@ -941,6 +1172,14 @@ void ye_editor_paint_project(struct nk_context *ctx){
                         build_platform_int = 0;
                         ye_version_tagify(build_engine_tag_name);
                         build_executable_path[0] = '\0';
+                        build_unity = false;
+                        build_pch = false;
+                        build_profiling = false;
+                        build_compiler_cache_int = 3;
+                        build_compiler_cache_size[0] = '\0';
+                        build_max_jobs = 0;
+                        build_optimization_int = 0;
+                        build_pgo_seconds = 30;
                     }
                 }
             }
@@ -959,6 +1198,36 @@ void ye_editor_paint_project(struct nk_context *ctx){
                     unlock_viewport();
                 }
             }
+            if(nk_button_image_label(ctx, editor_icons.build, "Build Log", NK_TEXT_CENTERED)){
+                if(!ui_component_exists("build log"))
+                    editor_panel_build_log_open();
+                else
+                    remove_ui_component("build log");
+            }
+            if(nk_button_image_label(ctx, editor_icons.buildreconfigure, "Build Matrix", NK_TEXT_CENTERED)){
+                if(!ui_component_exists("build matrix"))
+                    ui_register_component("build matrix", editor_panel_build_matrix);
+                else
+                    remove_ui_component("build matrix");
+            }
+            if(nk_button_image_label(ctx, editor_icons.game, "Game Monitor", NK_TEXT_CENTERED)){
+                if(!ui_component_exists("game"))
+                    editor_panel_game_open();
+                else
+                    remove_ui_component("game");
+            }
+            if(nk_button_image_label(ctx, editor_icons.trick, "Profile", NK_TEXT_CENTERED)){
+                if(!ui_component_exists("profile"))
+                    editor_panel_profile_open();
+                else
+                    remove_ui_component("profile");
+            }
+            if(nk_button_image_label(ctx, editor_icons.pack, "Size Report", NK_TEXT_CENTERED)){
+                if(!ui_component_exists("size report"))
+                    ui_register_component("size report", editor_panel_size_report);
+                else
+                    remove_ui_component("size report");
+            }
             nk_layout_row_dynamic(ctx, 25, 1);
             nk_layout_row_dynamic(ctx, 25, 1);
             nk_label_colored(ctx, "Copyright (c) Ryan Zmuda 2023-2025", NK_TEXT_CENTERED, nk_rgb(255, 255, 255));
@@ -13,6 +13,7 @@
 #include "editor_panels.h"
 #include "editor_selection.h"
 #include "editor_utils.h"
+#include "editor_pack.h"
 
 #include <yoyoengine/ye_nk.h>
 
@@ -28,7 +29,7 @@ void ye_editor_paint_hiearchy(struct nk_context *ctx){
             nk_layout_row_dynamic(ctx, 25, 1);
             nk_label(ctx, "Controls:", NK_TEXT_LEFT);
             if(nk_button_label(ctx, "New Entity")){
-                ye_create_entity();
+                editor_serialize_mark_dirty(ye_create_entity());
                 entity_list_head = ye_get_entity_list_head();
                 editor_unsaved();
             }
@@ -122,6 +123,7 @@ void ye_editor_paint_hiearchy(struct nk_context *ctx){
                 nk_checkbox_label(ctx, "", (nk_bool*)&current->entity->active);
 
                 if(current->entity->active != cached_active){
+                    editor_serialize_mark_dirty(current->entity);
                     editor_unsaved();
                 }
 
@@ -177,6 +179,7 @@ void ye_editor_paint_hiearchy(struct nk_context *ctx){
                 // duplicate button
                 if(nk_button_image(ctx, editor_icons.duplicate)){
                     struct ye_entity * new = ye_duplicate_entity(current->entity);
+                    editor_serialize_mark_dirty(new);
                     entity_list_head = ye_get_entity_list_head();
                     editor_unsaved();
 
@@ -199,6 +202,8 @@ void ye_editor_paint_hiearchy(struct nk_context *ctx){
                         editor_deselect(current->entity);
                     }
 
+                    // a new entity may get this pointer back
+                    editor_serialize_mark_dirty(current->entity);
                     ye_destroy_entity(current->entity);
                     editor_unsaved();
                     entity_list_head = ye_get_entity_list_head();
@@ -524,6 +529,7 @@ void ye_editor_paint_menu(struct nk_context *ctx){
 
                     // this should get the point across
                     struct ye_entity * warning = ye_create_entity_named("warning");
+                    editor_serialize_mark_dirty(warning);
                     ye_add_text_renderer_component(warning, 0, "Destroyed Scene. Please create or open a different one.", "default", 128, "red",0);
                 }
                 nk_popup_end(ctx);
@@ -580,7 +586,7 @@ void ye_editor_paint_menu(struct nk_context *ctx){
 
         nk_menubar_begin(ctx);
 
-        nk_layout_row_begin(ctx, NK_STATIC, 25, 9); // TO ADD NEW ITEMS: CHANGE THIS VALUE
+        nk_layout_row_begin(ctx, NK_STATIC, 25, 11); // TO ADD NEW ITEMS: CHANGE THIS VALUE
         /*
             File
             Scene
@@ -590,6 +596,7 @@ void ye_editor_paint_menu(struct nk_context *ctx){
             ---SPACER---
             error count
             warning count
+            build progress
             saved status
         */
         
@@ -619,7 +626,7 @@ void ye_editor_paint_menu(struct nk_context *ctx){
             */
         }
         nk_layout_row_push(ctx, 55);
-        if (nk_menu_begin_label(ctx, "Scene", NK_TEXT_LEFT, nk_vec2(200, 200))) {
+        if (nk_menu_begin_label(ctx, "Scene", NK_TEXT_LEFT, nk_vec2(200, 235))) {
             nk_layout_row_dynamic(ctx, 25, 1);
             
             if (nk_menu_item_label(ctx, "Open Scene", NK_TEXT_LEFT)) { // TODO: save prompt if unsaved
@@ -671,6 +678,10 @@ void ye_editor_paint_menu(struct nk_context *ctx){
                 }
             }
 
+            if(nk_menu_item_label(ctx, "Binary Scene", NK_TEXT_LEFT)){
+                editor_panel_scene_binary_open();
+            }
+
             nk_menu_end(ctx);
         }
         nk_layout_row_push(ctx, 85);
@@ -730,7 +741,7 @@ void ye_editor_paint_menu(struct nk_context *ctx){
         // get the amount of space (less on small screens more on large)
         int barlength = screenWidth / 1.5;
         int dropdown_length = 45 + 55 + 85 + 45 + 45;
-        int status_length = 110 + 110 + 110;
+        int status_length = 110 + 110 + 110 + 110 + 110;
         int margin = 50;
         int spacepx = ye_clamp(screenWidth - 1280,0,barlength - (dropdown_length + status_length) - margin);
         // int spacepx = ye_clamp(screenWidth - 1280,0,(45 + 55 + 85 + 45 + 45) - (110 + 110 + 110));
@@ -761,6 +772,49 @@ void ye_editor_paint_menu(struct nk_context *ctx){
                 nk_tooltip(ctx, "Open the console to view. (Help > Shortcuts) to see keybind.");
         }
 
+        // background build progress
+        if(EDITOR_STATE.is_building){
+            SDL_LockMutex(EDITOR_STATE.build_mutex);
+            nk_size progress = (nk_size)(EDITOR_STATE.build_progress * 100);
+            char build_tip[300];
+            snprintf(build_tip, sizeof(build_tip), "%s (%.0fs)", EDITOR_STATE.build_status_msg, (SDL_GetTicks() - EDITOR_STATE.build_start_ticks) / 1000.0f);
+            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+            nk_layout_row_push(ctx, 110);
+            struct nk_rect bounds = nk_widget_bounds(ctx);
+            nk_progress(ctx, &progress, 100, NK_FIXED);
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, build_tip);
+        }
+
+        // background pack progress, one entry per .yep
+        if(editor_pack_is_running()){
+            int done = 0;
+            char pack_tip[256] = "";
+            for(int i = 0; i < EDITOR_PACK_NUM_JOBS; i++){
+                struct editor_pack_job *job = &editor_pack_jobs[i];
+                char entry[96];
+                if(SDL_GetAtomicInt(&job->state) == EDITOR_PACK_RUNNING){
+                    snprintf(entry, sizeof(entry), "%s: packing (%.0fs)", job->name, (SDL_GetTicks() - job->start_ticks) / 1000.0f);
+                }
+                else{
+                    done++;
+                    snprintf(entry, sizeof(entry), "%s: done", job->name);
+                }
+                if(i > 0)
+                    strncat(pack_tip, "  |  ", sizeof(pack_tip) - strlen(pack_tip) - 1);
+                strncat(pack_tip, entry, sizeof(pack_tip) - strlen(pack_tip) - 1);
+            }
+
+            char buf[64];
+            snprintf(buf, sizeof(buf), "Packing %d/%d", done, EDITOR_PACK_NUM_JOBS);
+            nk_layout_row_push(ctx, 110);
+            struct nk_rect bounds = nk_widget_bounds(ctx);
+            nk_label_colored(ctx, buf, NK_TEXT_CENTERED, nk_rgb(255, 255, 0));
+            if (nk_input_is_mouse_hovering_rect(in, bounds))
+                nk_tooltip(ctx, pack_tip);
+        }
+
         // saved status
         nk_layout_row_push(ctx, 110);
         struct nk_rect bounds = nk_widget_bounds(ctx);
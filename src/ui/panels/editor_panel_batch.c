@@ -0,0 +1,227 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_batch.h"
+#include "editor_build_job.h"
+#include "editor_panels.h"
+
+// the welcome screen's list of recent projects
+extern json_t *project_cache;
+
+nk_bool batch_selected[EDITOR_BATCH_MAX];
+nk_bool batch_force_pack = false;
+int batch_log_project = 0;
+bool batch_focus = false;
+
+static const char *batch_status_names[] = {"Queued", "Running", "Done", "Failed", "Cancelled"};
+
+static struct nk_color batch_status_color(enum editor_batch_status status){
+    switch(status){
+        case EDITOR_BATCH_DONE:
+            return nk_rgb(0, 220, 120);
+        case EDITOR_BATCH_FAILED:
+            return nk_rgb(255, 90, 90);
+        case EDITOR_BATCH_CANCELLED:
+            return nk_rgb(255, 200, 60);
+        default:
+            return nk_rgb(220, 220, 220);
+    }
+}
+
+void editor_panel_batch_open(){
+    // everything is selected to begin with, "build all" is the common case
+    for(int i = 0; i < EDITOR_BATCH_MAX; i++)
+        batch_selected[i] = true;
+
+    batch_focus = true;
+    if(!ui_component_exists("batch build"))
+        ui_register_component("batch build", editor_panel_batch);
+}
+
+// "12.3s", or "-" for a step that did not run
+static void batch_seconds(char *out, size_t size, float seconds){
+    if(seconds > 0.0f)
+        snprintf(out, size, "%.1fs", seconds);
+    else
+        snprintf(out, size, "-");
+}
+
+void editor_panel_batch(struct nk_context *ctx){
+    if(nk_begin(ctx, "Batch Build", nk_rect(screenWidth / 2 - 375, screenHeight / 2 - 275, 750, 550), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        // the welcome screen is a full screen window, come up in front of it once
+        if(batch_focus){
+            nk_window_set_focus(ctx, "Batch Build");
+            batch_focus = false;
+        }
+
+        json_t *projects = json_object_get(project_cache, "projects");
+        int num_projects = (int)json_array_size(projects);
+        if(num_projects > EDITOR_BATCH_MAX)
+            num_projects = EDITOR_BATCH_MAX;
+
+        /*
+            Project picker
+        */
+        nk_layout_row_dynamic(ctx, 25, 1);
+        nk_label_colored(ctx, "Projects:", NK_TEXT_LEFT, nk_rgb(255, 255, 255));
+
+        nk_layout_row_dynamic(ctx, 110, 1);
+        if(nk_group_begin(ctx, "batch projects", NK_WINDOW_BORDER)){
+            for(int i = 0; i < num_projects; i++){
+                json_t *project = json_array_get(projects, i);
+                const char *name = json_string_value(json_object_get(project, "name"));
+                const char *path = json_string_value(json_object_get(project, "path"));
+
+                nk_layout_row_begin(ctx, NK_DYNAMIC, 20, 2);
+                nk_layout_row_push(ctx, 0.35f);
+                nk_checkbox_label(ctx, name ? name : "(unnamed)", &batch_selected[i]);
+                nk_layout_row_push(ctx, 0.65f);
+                nk_label_colored(ctx, path ? path : "", NK_TEXT_LEFT, nk_rgb(160, 160, 160));
+                nk_layout_row_end(ctx);
+            }
+            nk_group_end(ctx);
+        }
+
+        nk_layout_row_dynamic(ctx, 25, 4);
+        nk_property_int(ctx, "#At once:", 1, &editor_batch.max_parallel, EDITOR_BATCH_MAX, 1, 0.1f);
+        nk_property_int(ctx, "#Job budget:", 1, &editor_batch.job_budget, 256, 1, 0.1f);
+        nk_checkbox_label(ctx, "Force repack", &batch_force_pack);
+        editor_batch.force_pack = batch_force_pack;
+        nk_spacing(ctx, 1);
+
+        nk_layout_row_dynamic(ctx, 25, 3);
+        if(editor_batch.running){
+            if(nk_button_label(ctx, "Cancel"))
+                editor_batch_cancel();
+        }
+        else if(nk_button_image_label(ctx, editor_icons.build, "Build All", NK_TEXT_CENTERED)){
+            const char *names[EDITOR_BATCH_MAX];
+            const char *paths[EDITOR_BATCH_MAX];
+            int count = 0;
+            for(int i = 0; i < num_projects; i++){
+                json_t *project = json_array_get(projects, i);
+                const char *name = json_string_value(json_object_get(project, "name"));
+                const char *path = json_string_value(json_object_get(project, "path"));
+                if(!batch_selected[i] || !path)
+                    continue;
+                names[count] = name ? name : path;
+                paths[count] = path;
+                count++;
+            }
+            if(count > 0 && editor_batch_start(names, paths, count))
+                batch_log_project = 0;
+        }
+        nk_spacing(ctx, 1);
+        if(nk_button_label(ctx, "Close")){
+            remove_ui_component("batch build");
+        }
+
+        /*
+            Summary, one row per project, click a row to see its output below
+        */
+        if(editor_batch.num_projects > 0){
+            char cell[64];
+
+            nk_layout_row_dynamic(ctx, 20, 1);
+            if(editor_batch.running)
+                snprintf(cell, sizeof(cell), "Running for %.0fs", (SDL_GetTicks() - editor_batch.start_ticks) / 1000.0f);
+            else
+                snprintf(cell, sizeof(cell), "Finished in %.1fs", (editor_batch.end_ticks - editor_batch.start_ticks) / 1000.0f);
+            nk_label(ctx, cell, NK_TEXT_LEFT);
+
+            const float widths[] = {0.22f, 0.12f, 0.1f, 0.1f, 0.1f, 0.1f, 0.06f, 0.2f};
+            nk_layout_row(ctx, NK_DYNAMIC, 20, 8, widths);
+            nk_label(ctx, "Project", NK_TEXT_LEFT);
+            nk_label(ctx, "Status", NK_TEXT_LEFT);
+            nk_label(ctx, "Pack", NK_TEXT_RIGHT);
+            nk_label(ctx, "Configure", NK_TEXT_RIGHT);
+            nk_label(ctx, "Compile", NK_TEXT_RIGHT);
+            nk_label(ctx, "Total", NK_TEXT_RIGHT);
+            nk_label(ctx, "Jobs", NK_TEXT_RIGHT);
+            nk_label(ctx, "", NK_TEXT_LEFT);
+
+            for(int i = 0; i < editor_batch.num_projects; i++){
+                struct editor_batch_project *project = &editor_batch.projects[i];
+
+                nk_layout_row(ctx, NK_DYNAMIC, 20, 8, widths);
+                if(nk_select_label(ctx, project->name, NK_TEXT_LEFT, batch_log_project == i))
+                    batch_log_project = i;
+                nk_label_colored(ctx, batch_status_names[project->status], NK_TEXT_LEFT, batch_status_color(project->status));
+
+                if(project->status == EDITOR_BATCH_RUNNING){
+                    // live elapsed time, the step timings arrive once the build is through
+                    batch_seconds(cell, sizeof(cell), project->pack_seconds);
+                    nk_label(ctx, cell, NK_TEXT_RIGHT);
+                    nk_spacing(ctx, 2);
+                    batch_seconds(cell, sizeof(cell), (SDL_GetTicks() - project->start_ticks) / 1000.0f);
+                    nk_label(ctx, cell, NK_TEXT_RIGHT);
+                    nk_spacing(ctx, 1);
+
+                    SDL_LockMutex(EDITOR_STATE.build_mutex);
+                    nk_size progress = (nk_size)(project->job->progress * 100);
+                    SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+                    nk_progress(ctx, &progress, 100, NK_FIXED);
+                    continue;
+                }
+
+                batch_seconds(cell, sizeof(cell), project->pack_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                batch_seconds(cell, sizeof(cell), project->configure_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                batch_seconds(cell, sizeof(cell), project->compile_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                batch_seconds(cell, sizeof(cell), project->total_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                if(project->parallel_jobs > 0)
+                    snprintf(cell, sizeof(cell), "%d", project->parallel_jobs);
+                else
+                    snprintf(cell, sizeof(cell), "-");
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                nk_label_colored(ctx, project->message, NK_TEXT_LEFT, batch_status_color(project->status));
+            }
+        }
+
+        /*
+            Output of the selected project (packs and build)
+        */
+        if(batch_log_project < editor_batch.num_projects && editor_batch.projects[batch_log_project].job){
+            struct editor_batch_project *project = &editor_batch.projects[batch_log_project];
+            struct editor_log_ring *log = project->job->log;
+
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label_colored(ctx, project->path, NK_TEXT_LEFT, nk_rgb(160, 160, 160));
+
+            nk_layout_row_dynamic(ctx, 150, 1);
+            struct nk_list_view view;
+            editor_log_ring_lock(log);
+            int count = log->count;
+            if(nk_list_view_begin(ctx, &view, "batch output", NK_WINDOW_BORDER, 16, count)){
+                nk_layout_row_dynamic(ctx, 16, 1);
+                for(int i = view.begin; i < view.end; i++){
+                    const struct editor_log_line *line = editor_log_ring_line(log, i);
+                    if(!line)
+                        continue;
+                    if(line->kind == EDITOR_LOG_NORMAL)
+                        nk_label(ctx, line->text, NK_TEXT_LEFT);
+                    else
+                        nk_label_colored(ctx, line->text, NK_TEXT_LEFT, line->kind == EDITOR_LOG_ERROR ? nk_rgb(255, 90, 90) : nk_rgb(255, 200, 60));
+                }
+                nk_list_view_end(&view);
+            }
+            editor_log_ring_unlock(log);
+
+            if(project->status == EDITOR_BATCH_RUNNING)
+                nk_group_set_scroll(ctx, "batch output", 0, (nk_uint)(count * 16));
+        }
+
+        nk_end(ctx);
+    }
+}
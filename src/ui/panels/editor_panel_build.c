@@ -0,0 +1,322 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_build.h"
+#include "editor_build_job.h"
+#include "editor_utils.h"
+#include "editor_panels.h"
+
+// how long the build notification stays up before dismissing itself
+#define EDITOR_BUILD_NOTIFICATION_MS 5000
+
+bool build_notification_success = false;
+char build_notification_text[256];
+Uint64 build_notification_ticks = 0;
+
+void editor_panel_build_notify(bool success, const char *message){
+    build_notification_success = success;
+    snprintf(build_notification_text, sizeof(build_notification_text), "%s", message);
+    build_notification_ticks = SDL_GetTicks();
+
+    if(!ui_component_exists("build notification"))
+        ui_register_component("build notification", editor_panel_build_notification);
+}
+
+/*
+    Small toast in the bottom left corner of the viewport, does not lock
+    the viewport so editing continues while it is up
+*/
+void editor_panel_build_notification(struct nk_context *ctx){
+    if(SDL_GetTicks() - build_notification_ticks > EDITOR_BUILD_NOTIFICATION_MS){
+        remove_ui_component("build notification");
+        return;
+    }
+
+    if(nk_begin(ctx, "Build Result", nk_rect(10, 45 + (screenHeight / 1.5) - 110, 350, 100), NK_WINDOW_BORDER|NK_WINDOW_TITLE)){
+        nk_layout_row_dynamic(ctx, 25, 1);
+        if(build_notification_success)
+            nk_label_colored(ctx, build_notification_text, NK_TEXT_LEFT, nk_rgb(0, 255, 0));
+        else
+            nk_label_colored(ctx, build_notification_text, NK_TEXT_LEFT, nk_rgb(255, 0, 0));
+
+        if(nk_button_label(ctx, "Dismiss")){
+            build_notification_ticks = 0;
+        }
+        nk_end(ctx);
+    }
+}
+
+/*
+    Build log
+*/
+
+nk_bool build_log_follow = true;
+
+void editor_panel_build_log_open(){
+    build_log_follow = true;
+    if(!ui_component_exists("build log"))
+        ui_register_component("build log", editor_panel_build_log);
+}
+
+static struct nk_color build_log_color(enum editor_log_kind kind){
+    switch(kind){
+        case EDITOR_LOG_ERROR:
+            return nk_rgb(255, 90, 90);
+        case EDITOR_LOG_WARNING:
+            return nk_rgb(255, 200, 60);
+        default:
+            return nk_rgb(220, 220, 220);
+    }
+}
+
+void editor_panel_build_log(struct nk_context *ctx){
+    if(nk_begin(ctx, "Build Log", nk_rect(screenWidth / 2 - 400, screenHeight / 2 - 250, 800, 500), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        /*
+            Status header
+        */
+        char status[300];
+        nk_size progress = 0;
+        int num_errors = 0, num_warnings = 0;
+
+        SDL_LockMutex(EDITOR_STATE.build_mutex);
+        snprintf(status, sizeof(status), "%s", EDITOR_STATE.is_building ? EDITOR_STATE.build_status_msg : (editor_build_log.count > 0 ? "Build finished." : "No build has run yet."));
+        progress = (nk_size)(EDITOR_STATE.build_progress * 100);
+        for(int i = 0; i < editor_build_num_diagnostics; i++){
+            if(editor_build_diagnostics[i].is_error)
+                num_errors++;
+            else
+                num_warnings++;
+        }
+        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 5);
+        nk_layout_row_push(ctx, 0.38f);
+        nk_label(ctx, status, NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.22f);
+        if(EDITOR_STATE.is_building)
+            nk_progress(ctx, &progress, 100, NK_FIXED);
+        else{
+            char counts[64];
+            snprintf(counts, sizeof(counts), "%d errors, %d warnings", num_errors, num_warnings);
+            nk_label(ctx, counts, NK_TEXT_LEFT);
+        }
+        nk_layout_row_push(ctx, 0.13f);
+        nk_checkbox_label(ctx, "Follow", &build_log_follow);
+        nk_layout_row_push(ctx, 0.13f);
+        if(EDITOR_STATE.is_building){
+            if(nk_button_label(ctx, "Cancel"))
+                editor_build_cancel();
+        }
+        else{
+            nk_spacing(ctx, 1);
+        }
+        nk_layout_row_push(ctx, 0.13f);
+        if(nk_button_label(ctx, "Close")){
+            remove_ui_component("build log");
+        }
+        nk_layout_row_end(ctx);
+
+        float body_height = nk_window_get_content_region(ctx).h - 40;
+
+        SDL_LockMutex(EDITOR_STATE.build_mutex);
+        struct editor_build_cache_stats cache_stats = editor_build_cache_stats;
+        SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+        if(cache_stats.valid){
+            long total = cache_stats.hits + cache_stats.misses;
+            char cache_line[128];
+            snprintf(cache_line, sizeof(cache_line), "Compiler cache: %ld hits, %ld misses (%.0f%% hit rate)",
+                cache_stats.hits, cache_stats.misses, total > 0 ? 100.0 * cache_stats.hits / total : 0.0);
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label(ctx, cache_line, NK_TEXT_LEFT);
+            body_height -= 25;
+        }
+
+        /*
+            Diagnostics, clicking one opens the file and copies its location
+        */
+        if(num_errors + num_warnings > 0){
+            nk_layout_row_dynamic(ctx, body_height * 0.3f, 1);
+            if(nk_group_begin(ctx, "build diagnostics", NK_WINDOW_BORDER)){
+                nk_layout_row_dynamic(ctx, 20, 1);
+
+                SDL_LockMutex(EDITOR_STATE.build_mutex);
+                for(int i = 0; i < editor_build_num_diagnostics; i++){
+                    struct editor_build_diagnostic *diag = &editor_build_diagnostics[i];
+
+                    // show the file name, the full path is in the tooltip
+                    const char *name = strrchr(diag->file, '/');
+                    name = name ? name + 1 : diag->file;
+
+                    char label[700];
+                    snprintf(label, sizeof(label), "%s:%d  %s", name, diag->line, diag->message);
+
+                    struct nk_rect bounds = nk_widget_bounds(ctx);
+                    if(nk_widget_is_mouse_clicked(ctx, NK_BUTTON_LEFT)){
+                        char location[600];
+                        snprintf(location, sizeof(location), "%s:%d", diag->file, diag->line);
+                        SDL_SetClipboardText(location);
+                        editor_open_in_system(diag->file);
+                    }
+                    nk_label_colored(ctx, label, NK_TEXT_LEFT, build_log_color(diag->is_error ? EDITOR_LOG_ERROR : EDITOR_LOG_WARNING));
+
+                    if(nk_input_is_mouse_hovering_rect(&ctx->input, bounds)){
+                        char tip[600];
+                        snprintf(tip, sizeof(tip), "%s:%d (click to open, location copied to clipboard)", diag->file, diag->line);
+                        nk_tooltip(ctx, tip);
+                    }
+                }
+                SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+                nk_group_end(ctx);
+            }
+            body_height *= 0.7f;
+        }
+
+        /*
+            Raw output, only the visible rows are laid out
+        */
+        nk_layout_row_dynamic(ctx, body_height, 1);
+        struct nk_list_view view;
+        editor_log_ring_lock(&editor_build_log);
+        int count = editor_build_log.count;
+        if(nk_list_view_begin(ctx, &view, "build output", NK_WINDOW_BORDER, 16, count)){
+            nk_layout_row_dynamic(ctx, 16, 1);
+            for(int i = view.begin; i < view.end; i++){
+                const struct editor_log_line *line = editor_log_ring_line(&editor_build_log, i);
+                if(line)
+                    nk_label_colored(ctx, line->text, NK_TEXT_LEFT, build_log_color(line->kind));
+            }
+            nk_list_view_end(&view);
+        }
+        editor_log_ring_unlock(&editor_build_log);
+
+        // keep the newest output in view while the build runs
+        if(build_log_follow && EDITOR_STATE.is_building)
+            nk_group_set_scroll(ctx, "build output", 0, (nk_uint)(count * 16));
+
+        nk_end(ctx);
+    }
+}
+
+/*
+    Build matrix
+*/
+
+static const char *build_matrix_platforms[] = {"linux", "windows", "emscripten"};
+static const char *build_matrix_modes[] = {"Debug", "Release"};
+
+// rows are modes, columns are platforms
+nk_bool build_matrix_selected[2][3] = {{true, false, false}, {false, false, false}};
+int build_matrix_log_job = 0;
+
+void editor_panel_build_matrix(struct nk_context *ctx){
+    if(nk_begin(ctx, "Build Matrix", nk_rect(screenWidth / 2 - 350, screenHeight / 2 - 250, 700, 500), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        bool running = editor_build_matrix_running();
+
+        /*
+            Configuration picker
+        */
+        nk_layout_row_dynamic(ctx, 25, 4);
+        nk_spacing(ctx, 1);
+        for(int p = 0; p < 3; p++)
+            nk_label(ctx, build_matrix_platforms[p], NK_TEXT_CENTERED);
+        for(int m = 0; m < 2; m++){
+            nk_label(ctx, build_matrix_modes[m], NK_TEXT_LEFT);
+            for(int p = 0; p < 3; p++)
+                nk_checkbox_label(ctx, "", &build_matrix_selected[m][p]);
+        }
+
+        nk_layout_row_dynamic(ctx, 25, 3);
+        if(running){
+            if(nk_button_label(ctx, "Cancel"))
+                editor_build_matrix_cancel();
+        }
+        else if(nk_button_image_label(ctx, editor_icons.build, "Build", NK_TEXT_CENTERED)){
+            struct editor_build_config configs[6];
+            int count = 0;
+            for(int m = 0; m < 2; m++){
+                for(int p = 0; p < 3; p++){
+                    if(!build_matrix_selected[m][p])
+                        continue;
+                    snprintf(configs[count].platform, sizeof(configs[count].platform), "%s", build_matrix_platforms[p]);
+                    snprintf(configs[count].build_mode, sizeof(configs[count].build_mode), "%s", build_matrix_modes[m]);
+                    count++;
+                }
+            }
+            if(count > 0 && editor_build_matrix_start(configs, count))
+                build_matrix_log_job = 0;
+        }
+        nk_spacing(ctx, 1);
+        if(nk_button_label(ctx, "Close")){
+            remove_ui_component("build matrix");
+        }
+
+        /*
+            One row per job, click a row to see its output below
+        */
+        for(int i = 0; i < editor_build_matrix_count; i++){
+            struct editor_build_job *job = editor_build_matrix_jobs[i];
+
+            SDL_LockMutex(EDITOR_STATE.build_mutex);
+            int status = job->status;
+            nk_size progress = (nk_size)(job->progress * 100);
+            char status_msg[256];
+            snprintf(status_msg, sizeof(status_msg), "%s", job->status_msg);
+            int num_errors = job->num_errors;
+            SDL_UnlockMutex(EDITOR_STATE.build_mutex);
+
+            if(status == 1)
+                snprintf(status_msg, sizeof(status_msg), "Built in %.1fs", (job->end_ticks - job->start_ticks) / 1000.0f);
+
+            char errors[32];
+            snprintf(errors, sizeof(errors), "%d errors", num_errors);
+
+            nk_layout_row_begin(ctx, NK_DYNAMIC, 22, 4);
+            nk_layout_row_push(ctx, 0.25f);
+            if(nk_select_label(ctx, job->label, NK_TEXT_LEFT, build_matrix_log_job == i))
+                build_matrix_log_job = i;
+            nk_layout_row_push(ctx, 0.25f);
+            nk_progress(ctx, &progress, 100, NK_FIXED);
+            nk_layout_row_push(ctx, 0.35f);
+            nk_label_colored(ctx, status_msg, NK_TEXT_LEFT, status == 2 ? build_log_color(EDITOR_LOG_ERROR) : build_log_color(EDITOR_LOG_NORMAL));
+            nk_layout_row_push(ctx, 0.15f);
+            nk_label(ctx, errors, NK_TEXT_RIGHT);
+            nk_layout_row_end(ctx);
+        }
+
+        /*
+            Output of the selected job
+        */
+        if(build_matrix_log_job < editor_build_matrix_count){
+            struct editor_log_ring *log = editor_build_matrix_jobs[build_matrix_log_job]->log;
+
+            nk_layout_row_dynamic(ctx, nk_window_get_content_region(ctx).h - 205 - editor_build_matrix_count * 26, 1);
+            struct nk_list_view view;
+            editor_log_ring_lock(log);
+            int count = log->count;
+            if(nk_list_view_begin(ctx, &view, "build matrix output", NK_WINDOW_BORDER, 16, count)){
+                nk_layout_row_dynamic(ctx, 16, 1);
+                for(int i = view.begin; i < view.end; i++){
+                    const struct editor_log_line *line = editor_log_ring_line(log, i);
+                    if(line)
+                        nk_label_colored(ctx, line->text, NK_TEXT_LEFT, build_log_color(line->kind));
+                }
+                nk_list_view_end(&view);
+            }
+            editor_log_ring_unlock(log);
+
+            if(running)
+                nk_group_set_scroll(ctx, "build matrix output", 0, (nk_uint)(count * 16));
+        }
+
+        nk_end(ctx);
+    }
+}
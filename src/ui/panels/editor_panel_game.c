@@ -0,0 +1,133 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_log.h"
+#include "editor_game.h"
+#include "editor_panels.h"
+
+nk_bool game_output_follow = true;
+
+void editor_panel_game_open(){
+    game_output_follow = true;
+    if(!ui_component_exists("game"))
+        ui_register_component("game", editor_panel_game);
+}
+
+void editor_panel_game(struct nk_context *ctx){
+    if(nk_begin(ctx, "Game", nk_rect(screenWidth / 2 - 400, screenHeight / 2 - 250, 800, 500), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        struct nk_input *in = &ctx->input;
+
+        /*
+            State, copied out so the supervisor is not held up while we draw
+        */
+        editor_game_lock();
+        struct editor_game_state game = editor_game;
+        editor_game_unlock();
+
+        char status[256];
+        if(!game.launched)
+            snprintf(status, sizeof(status), "No game launched yet.");
+        else if(game.running)
+            snprintf(status, sizeof(status), "Running (pid %lld) for %.0fs", (long long)game.pid, (SDL_GetTicks() - game.start_ticks) / 1000.0f);
+        else
+            snprintf(status, sizeof(status), "Exited with code %d after %.1fs", game.exit_code, (game.end_ticks - game.start_ticks) / 1000.0f);
+
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 4);
+        nk_layout_row_push(ctx, 0.55f);
+        if(game.launched && !game.running && game.exit_code != 0)
+            nk_label_colored(ctx, status, NK_TEXT_LEFT, nk_rgb(255, 90, 90));
+        else
+            nk_label(ctx, status, NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.15f);
+        nk_checkbox_label(ctx, "Follow", &game_output_follow);
+        nk_layout_row_push(ctx, 0.15f);
+        if(game.running){
+            if(nk_button_label(ctx, "Stop"))
+                editor_game_stop(false);
+        }
+        else{
+            nk_spacing(ctx, 1);
+        }
+        nk_layout_row_push(ctx, 0.15f);
+        if(nk_button_label(ctx, "Close")){
+            remove_ui_component("game");
+        }
+        nk_layout_row_end(ctx);
+
+        float body_height = nk_window_get_content_region(ctx).h - 40;
+
+        /*
+            CPU and memory over the last minute
+        */
+        if(game.can_sample && game.num_samples > 0){
+            struct editor_game_sample *last = &game.samples[game.num_samples - 1];
+
+            float max_cpu = 100.0f, max_rss = 1.0f, peak_rss = 0.0f;
+            for(int i = 0; i < game.num_samples; i++){
+                if(game.samples[i].cpu_percent > max_cpu)
+                    max_cpu = game.samples[i].cpu_percent;
+                if(game.samples[i].rss_mb > peak_rss)
+                    peak_rss = game.samples[i].rss_mb;
+            }
+            max_rss = peak_rss * 1.25f;
+
+            char stats[256];
+            snprintf(stats, sizeof(stats), "CPU %.0f%%   RSS %.1f MiB (peak %.1f)   %d threads",
+                last->cpu_percent, last->rss_mb, peak_rss, last->threads);
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label(ctx, stats, NK_TEXT_LEFT);
+
+            nk_layout_row_dynamic(ctx, 100, 1);
+            struct nk_rect bounds = nk_widget_bounds(ctx);
+            if(nk_chart_begin_colored(ctx, NK_CHART_LINES, nk_rgb(255, 140, 0), nk_rgb(255, 140, 0), EDITOR_GAME_MAX_SAMPLES, 0, max_cpu)){
+                nk_chart_add_slot_colored(ctx, NK_CHART_LINES, nk_rgb(0, 160, 255), nk_rgb(0, 160, 255), EDITOR_GAME_MAX_SAMPLES, 0, max_rss);
+                for(int i = 0; i < game.num_samples; i++){
+                    nk_chart_push_slot(ctx, game.samples[i].cpu_percent, 0);
+                    nk_chart_push_slot(ctx, game.samples[i].rss_mb, 1);
+                }
+                nk_chart_end(ctx);
+            }
+            if (nk_input_is_mouse_hovering_rect(in, bounds)){
+                char tip[128];
+                snprintf(tip, sizeof(tip), "Last minute: orange = CPU (0-%.0f%%), blue = RSS (0-%.0f MiB)", max_cpu, max_rss);
+                nk_tooltip(ctx, tip);
+            }
+            body_height -= 130;
+        }
+        else if(game.launched && !game.can_sample){
+            nk_layout_row_dynamic(ctx, 20, 1);
+            nk_label(ctx, "CPU and memory sampling is only available on Linux.", NK_TEXT_LEFT);
+            body_height -= 25;
+        }
+
+        /*
+            Output
+        */
+        nk_layout_row_dynamic(ctx, body_height, 1);
+        struct nk_list_view view;
+        editor_log_ring_lock(&editor_game_log);
+        int count = editor_game_log.count;
+        if(nk_list_view_begin(ctx, &view, "game output", NK_WINDOW_BORDER, 16, count)){
+            nk_layout_row_dynamic(ctx, 16, 1);
+            for(int i = view.begin; i < view.end; i++){
+                const struct editor_log_line *line = editor_log_ring_line(&editor_game_log, i);
+                if(line)
+                    nk_label(ctx, line->text, NK_TEXT_LEFT);
+            }
+            nk_list_view_end(&view);
+        }
+        editor_log_ring_unlock(&editor_game_log);
+
+        if(game_output_follow && game.running)
+            nk_group_set_scroll(ctx, "game output", 0, (nk_uint)(count * 16));
+
+        nk_end(ctx);
+    }
+}
@@ -0,0 +1,153 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_profile.h"
+#include "editor_panels.h"
+
+// call graph index of the function whose callers/callees are shown, -1 for none
+int profile_selected_index = -1;
+
+static const float profile_columns[] = {0.37f, 0.09f, 0.09f, 0.09f, 0.12f, 0.12f, 0.12f};
+
+void editor_panel_profile_open(){
+    profile_selected_index = -1;
+    if(!ui_component_exists("profile"))
+        ui_register_component("profile", editor_panel_profile);
+}
+
+static void profile_sort_header(struct nk_context *ctx, const char *label, enum editor_profile_sort_key key, enum editor_profile_sort_key current){
+    nk_bool selected = key == current;
+    if(nk_selectable_label(ctx, label, NK_TEXT_CENTERED, &selected) && key != current)
+        editor_profile_sort(key);
+}
+
+static void profile_arc_row(struct nk_context *ctx, const struct editor_profile_arc *arc){
+    char cell[64];
+    nk_layout_row_begin(ctx, NK_DYNAMIC, 16, 4);
+    nk_layout_row_push(ctx, 0.55f);
+    nk_label(ctx, arc->name, NK_TEXT_LEFT);
+    nk_layout_row_push(ctx, 0.15f);
+    snprintf(cell, sizeof(cell), "%.2fs", arc->self_seconds);
+    nk_label(ctx, cell, NK_TEXT_RIGHT);
+    nk_layout_row_push(ctx, 0.15f);
+    snprintf(cell, sizeof(cell), "%.2fs", arc->child_seconds);
+    nk_label(ctx, cell, NK_TEXT_RIGHT);
+    nk_layout_row_push(ctx, 0.15f);
+    nk_label(ctx, arc->calls, NK_TEXT_RIGHT);
+    nk_layout_row_end(ctx);
+}
+
+void editor_panel_profile(struct nk_context *ctx){
+    if(nk_begin(ctx, "Profile", nk_rect(screenWidth / 2 - 450, screenHeight / 2 - 300, 900, 600), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        /*
+            The sort buttons reorder the functions, so the lock is
+            held for the whole panel rather than copying the profile
+        */
+        editor_profile_lock();
+
+        char header[512];
+        if(editor_profile.source[0])
+            snprintf(header, sizeof(header), "%s - %s", editor_profile.source, editor_profile.status_msg);
+        else
+            snprintf(header, sizeof(header), "No profile yet. Build with \"Profiling Build\" enabled, run the game and quit it normally.");
+
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 2);
+        nk_layout_row_push(ctx, 0.85f);
+        if(editor_profile.status == 3)
+            nk_label_colored(ctx, header, NK_TEXT_LEFT, nk_rgb(255, 90, 90));
+        else
+            nk_label(ctx, header, NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.15f);
+        bool close = nk_button_label(ctx, "Close");
+        nk_layout_row_end(ctx);
+
+        float content_height = nk_window_get_content_region(ctx).h - 40;
+        float graph_height = profile_selected_index >= 0 ? 180 : 0;
+
+        /*
+            Flat profile, sortable by clicking a column header
+        */
+        nk_layout_row(ctx, NK_DYNAMIC, 20, 7, profile_columns);
+        enum editor_profile_sort_key current = editor_profile.sort_key;
+        profile_sort_header(ctx, "Function", EDITOR_PROFILE_SORT_NAME, current);
+        nk_label(ctx, "% time", NK_TEXT_CENTERED);
+        profile_sort_header(ctx, "Self", EDITOR_PROFILE_SORT_SELF, current);
+        profile_sort_header(ctx, "Total", EDITOR_PROFILE_SORT_TOTAL, current);
+        profile_sort_header(ctx, "Calls", EDITOR_PROFILE_SORT_CALLS, current);
+        profile_sort_header(ctx, "Self ms/call", EDITOR_PROFILE_SORT_SELF_PER_CALL, current);
+        profile_sort_header(ctx, "Total ms/call", EDITOR_PROFILE_SORT_TOTAL_PER_CALL, current);
+
+        nk_layout_row_dynamic(ctx, content_height - graph_height - 25, 1);
+        struct nk_list_view view;
+        if(nk_list_view_begin(ctx, &view, "profile functions", NK_WINDOW_BORDER, 18, editor_profile.num_functions)){
+            for(int i = view.begin; i < view.end; i++){
+                struct editor_profile_function *function = &editor_profile.functions[i];
+                char cell[64];
+
+                nk_layout_row(ctx, NK_DYNAMIC, 18, 7, profile_columns);
+                nk_bool selected = function->index >= 0 && function->index == profile_selected_index;
+                if(nk_selectable_label(ctx, function->name, NK_TEXT_LEFT, &selected))
+                    profile_selected_index = selected ? function->index : -1;
+                snprintf(cell, sizeof(cell), "%.2f", function->percent);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                snprintf(cell, sizeof(cell), "%.2fs", function->self_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                snprintf(cell, sizeof(cell), "%.2fs", function->total_seconds);
+                nk_label(ctx, cell, NK_TEXT_RIGHT);
+                if(function->calls >= 0){
+                    snprintf(cell, sizeof(cell), "%ld", function->calls);
+                    nk_label(ctx, cell, NK_TEXT_RIGHT);
+                    // converted to ms whatever unit gprof printed, %g keeps sub microsecond calls readable
+                    snprintf(cell, sizeof(cell), "%.4g", function->self_ms_per_call);
+                    nk_label(ctx, cell, NK_TEXT_RIGHT);
+                    snprintf(cell, sizeof(cell), "%.4g", function->total_ms_per_call);
+                    nk_label(ctx, cell, NK_TEXT_RIGHT);
+                }
+                else{
+                    // not compiled with -pg (system libraries), only sampled
+                    nk_label(ctx, "-", NK_TEXT_RIGHT);
+                    nk_label(ctx, "-", NK_TEXT_RIGHT);
+                    nk_label(ctx, "-", NK_TEXT_RIGHT);
+                }
+            }
+            nk_list_view_end(&view);
+        }
+
+        /*
+            Call graph entry of the selected function
+        */
+        if(profile_selected_index >= 0){
+            nk_layout_row_dynamic(ctx, graph_height - 5, 1);
+            if(nk_group_begin(ctx, "profile call graph", NK_WINDOW_BORDER)){
+                nk_layout_row_dynamic(ctx, 18, 1);
+                nk_label_colored(ctx, "Called by (self / children / calls):", NK_TEXT_LEFT, nk_rgb(255, 255, 255));
+                for(int i = 0; i < editor_profile.num_arcs; i++){
+                    if(editor_profile.arcs[i].owner == profile_selected_index && editor_profile.arcs[i].is_caller)
+                        profile_arc_row(ctx, &editor_profile.arcs[i]);
+                }
+
+                nk_layout_row_dynamic(ctx, 18, 1);
+                nk_label_colored(ctx, "Calls (self / children / calls):", NK_TEXT_LEFT, nk_rgb(255, 255, 255));
+                for(int i = 0; i < editor_profile.num_arcs; i++){
+                    if(editor_profile.arcs[i].owner == profile_selected_index && !editor_profile.arcs[i].is_caller)
+                        profile_arc_row(ctx, &editor_profile.arcs[i]);
+                }
+                nk_group_end(ctx);
+            }
+        }
+
+        editor_profile_unlock();
+
+        if(close)
+            remove_ui_component("profile");
+
+        nk_end(ctx);
+    }
+}
@@ -0,0 +1,184 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_utils.h"
+#include "editor_serialize.h"
+#include "editor_scene_binary.h"
+#include "editor_selection.h"
+#include "editor_panels.h"
+
+// both relative to the project resources
+char scene_binary_json[256] = "";
+char scene_binary_file[256] = "";
+int scene_binary_runs = 10;
+char scene_binary_status[512] = "";
+bool scene_binary_status_error = false;
+
+struct editor_scene_binary_benchmark scene_binary_result;
+bool scene_binary_has_result = false;
+
+void editor_panel_scene_binary_open(){
+    // default to the open scene
+    snprintf(scene_binary_json, sizeof(scene_binary_json), "%s", YE_STATE.runtime.scene_file_path ? YE_STATE.runtime.scene_file_path : "");
+    editor_scene_binary_path(scene_binary_json, scene_binary_file, sizeof(scene_binary_file));
+    scene_binary_status[0] = '\0';
+
+    if(!ui_component_exists("scene binary"))
+        ui_register_component("scene binary", editor_panel_scene_binary);
+}
+
+static void scene_binary_set_status(bool ok, const char *message){
+    snprintf(scene_binary_status, sizeof(scene_binary_status), "%s", message);
+    scene_binary_status_error = !ok;
+}
+
+static void scene_binary_set_failure(const char *reason){
+    ye_logf(error, "Binary scene: %s\n", reason);
+    snprintf(scene_binary_status, sizeof(scene_binary_status), "Failed: %s", reason);
+    scene_binary_status_error = true;
+}
+
+static void scene_binary_ms_row(struct nk_context *ctx, const char *name, double json_ms, double binary_ms){
+    char cell[32];
+    nk_label(ctx, name, NK_TEXT_LEFT);
+    snprintf(cell, sizeof(cell), "%.2f ms", json_ms);
+    nk_label(ctx, cell, NK_TEXT_RIGHT);
+    snprintf(cell, sizeof(cell), "%.2f ms", binary_ms);
+    nk_label(ctx, cell, NK_TEXT_RIGHT);
+    snprintf(cell, sizeof(cell), "%.1fx", binary_ms > 0 ? json_ms / binary_ms : 0.0);
+    nk_label(ctx, cell, NK_TEXT_RIGHT);
+}
+
+void editor_panel_scene_binary(struct nk_context *ctx){
+    if(nk_begin(ctx, "Binary Scene", nk_rect(screenWidth / 2 - 300, screenHeight / 2 - 225, 600, 450), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        // ye_path_resources hands out a static buffer, so copy both right away
+        char json_path[1024], binary_path[1024];
+        snprintf(json_path, sizeof(json_path), "%s", ye_path_resources(scene_binary_json));
+        snprintf(binary_path, sizeof(binary_path), "%s", ye_path_resources(scene_binary_file));
+
+        /*
+            Files
+        */
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 2);
+        nk_layout_row_push(ctx, 0.2f);
+        nk_label(ctx, "JSON:", NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.8f);
+        nk_edit_string_zero_terminated(ctx, NK_EDIT_FIELD, scene_binary_json, sizeof(scene_binary_json), nk_filter_default);
+        nk_layout_row_end(ctx);
+
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 2);
+        nk_layout_row_push(ctx, 0.2f);
+        nk_label(ctx, "Binary:", NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.8f);
+        nk_edit_string_zero_terminated(ctx, NK_EDIT_FIELD, scene_binary_file, sizeof(scene_binary_file), nk_filter_default);
+        nk_layout_row_end(ctx);
+
+        nk_layout_row_dynamic(ctx, 25, 3);
+        if(nk_button_label(ctx, "JSON -> Binary")){
+            // a save in flight could still be writing the JSON
+            editor_serialize_wait();
+            char error[512];
+            if(editor_scene_binary_from_json(json_path, binary_path, error, sizeof(error)))
+                scene_binary_set_status(true, "Wrote the binary scene.");
+            else
+                scene_binary_set_failure(error);
+        }
+        if(nk_button_label(ctx, "Binary -> JSON")){
+            editor_serialize_wait();
+            bool open_scene = YE_STATE.runtime.scene_file_path && strcmp(scene_binary_json, YE_STATE.runtime.scene_file_path) == 0;
+            char error[512];
+
+            // overwriting the open scene would throw the unsaved edits away
+            if(open_scene && unsaved)
+                scene_binary_set_status(false, "The open scene has unsaved changes, save or reload it first.");
+            else if(editor_scene_binary_to_json(binary_path, json_path, error, sizeof(error))){
+                scene_binary_set_status(true, "Wrote the JSON scene.");
+
+                // the open scene was replaced underneath us, reload it like CTRL+SHIFT+R
+                if(open_scene){
+                    editor_deselect_all();
+                    ye_reload_scene();
+                    editor_re_attach_ecs();
+                    editor_saved();
+                }
+            }
+            else
+                scene_binary_set_failure(error);
+        }
+        if(nk_button_label(ctx, "Close")){
+            remove_ui_component("scene binary");
+        }
+
+        /*
+            Writing a binary copy next to every save of the JSON
+        */
+        nk_bool alongside = json_is_true(json_object_get(SETTINGS, "binary_scenes"));
+        nk_layout_row_dynamic(ctx, 25, 1);
+        if(nk_checkbox_label(ctx, "Write a binary copy on every scene save", &alongside)){
+            json_object_set_new(SETTINGS, "binary_scenes", alongside ? json_true() : json_false());
+            ye_json_write(ye_path("settings.yoyo"), SETTINGS);
+        }
+
+        /*
+            Benchmark
+        */
+        nk_layout_row_dynamic(ctx, 25, 2);
+        nk_property_int(ctx, "#Runs:", 1, &scene_binary_runs, 1000, 1, 0.5f);
+        if(nk_button_label(ctx, "Benchmark JSON")){
+            editor_serialize_wait();
+            char error[512];
+            scene_binary_has_result = editor_scene_binary_benchmark(json_path, scene_binary_runs, &scene_binary_result, error, sizeof(error));
+            if(scene_binary_has_result)
+                scene_binary_set_status(scene_binary_result.lossless, scene_binary_result.lossless ? "Benchmark done, the binary round trip is lossless." : "Benchmark done, but the binary round trip does not match the JSON!");
+            else
+                scene_binary_set_failure(error);
+        }
+
+        if(scene_binary_status[0]){
+            nk_layout_row_dynamic(ctx, 20, 1);
+            if(scene_binary_status_error)
+                nk_label_colored(ctx, scene_binary_status, NK_TEXT_LEFT, nk_rgb(255, 90, 90));
+            else
+                nk_label(ctx, scene_binary_status, NK_TEXT_LEFT);
+        }
+
+        if(scene_binary_has_result){
+            struct editor_scene_binary_benchmark *result = &scene_binary_result;
+            char cell[64];
+
+            nk_layout_row_dynamic(ctx, 20, 1);
+            snprintf(cell, sizeof(cell), "Best of %d runs, in memory:", result->iterations);
+            nk_label_colored(ctx, cell, NK_TEXT_LEFT, nk_rgb(255, 255, 255));
+
+            const float widths[] = {0.31f, 0.23f, 0.23f, 0.23f};
+            nk_layout_row(ctx, NK_DYNAMIC, 20, 4, widths);
+            nk_label(ctx, "", NK_TEXT_LEFT);
+            nk_label(ctx, "JSON", NK_TEXT_RIGHT);
+            nk_label(ctx, "Binary", NK_TEXT_RIGHT);
+            nk_label(ctx, "Gain", NK_TEXT_RIGHT);
+
+            nk_layout_row(ctx, NK_DYNAMIC, 20, 4, widths);
+            nk_label(ctx, "Size", NK_TEXT_LEFT);
+            editor_format_bytes((Sint64)result->json_bytes, false, cell, sizeof(cell));
+            nk_label(ctx, cell, NK_TEXT_RIGHT);
+            editor_format_bytes((Sint64)result->binary_bytes, false, cell, sizeof(cell));
+            nk_label(ctx, cell, NK_TEXT_RIGHT);
+            snprintf(cell, sizeof(cell), "%.1fx", result->binary_bytes > 0 ? (double)result->json_bytes / result->binary_bytes : 0.0);
+            nk_label(ctx, cell, NK_TEXT_RIGHT);
+
+            nk_layout_row(ctx, NK_DYNAMIC, 20, 4, widths);
+            scene_binary_ms_row(ctx, "Load", result->json_load_ms, result->binary_load_ms);
+            nk_layout_row(ctx, NK_DYNAMIC, 20, 4, widths);
+            scene_binary_ms_row(ctx, "Save", result->json_save_ms, result->binary_save_ms);
+        }
+
+        nk_end(ctx);
+    }
+}
@@ -9,6 +9,7 @@
 
 #include "editor.h"
 #include "editor_panels.h"
+#include "editor_serialize.h"
 
 // TODO: move me to utils for editor and use everywhere
 struct nk_rect editor_panel_bounds_centered(int w, int h){
@@ -212,9 +213,15 @@ void editor_panel_scene_settings(struct nk_context *ctx){
                 json_object_del(_scene, "music");
             }
 
+            // a save still in flight would rename its copy over ours
+            editor_serialize_wait();
+
             // write to file
             ye_json_write(ye_path_resources(YE_STATE.runtime.scene_file_path), SCENE);
 
+            // the next save has to pick these changes up instead of its cached copy of the file
+            editor_serialize_invalidate();
+
             editor_saved();
 
             remove_ui_component("scene_settings");
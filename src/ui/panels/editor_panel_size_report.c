@@ -0,0 +1,94 @@
+/*
+    This file is a part of yoyoengine. (https://github.com/zoogies/yoyoengine)
+    Copyright (C) 2023-2025  Ryan Zmuda
+
+    Licensed under the MIT license. See LICENSE file in the project root for details.
+*/
+
+#include <yoyoengine/yoyoengine.h>
+
+#include "editor.h"
+#include "editor_utils.h"
+#include "editor_size_report.h"
+#include "editor_panels.h"
+
+nk_bool size_report_only_changes = false;
+
+static const char *size_report_titles[EDITOR_SIZE_NUM_KINDS] = {
+    "Shipped files",
+    "Executable sections",
+    "Executable symbols (by name prefix)",
+    "Pack contents by directory",
+    "Pack contents by file type"
+};
+
+static void size_report_row(struct nk_context *ctx, const struct editor_size_entry *entry, bool has_previous){
+    char size[32], delta[32];
+    editor_format_bytes(entry->bytes, false, size, sizeof(size));
+
+    Sint64 change = entry->previous >= 0 ? entry->bytes - entry->previous : entry->bytes;
+    if(!has_previous)
+        snprintf(delta, sizeof(delta), "-");
+    else if(entry->previous < 0)
+        snprintf(delta, sizeof(delta), "new");
+    else if(entry->bytes == 0)
+        snprintf(delta, sizeof(delta), "removed");
+    else
+        editor_format_bytes(change, true, delta, sizeof(delta));
+
+    static const float columns[] = {0.2f, 0.4f, 0.2f, 0.2f};
+    nk_layout_row(ctx, NK_DYNAMIC, 18, 4, columns);
+    nk_label(ctx, entry->group, NK_TEXT_LEFT);
+    nk_label(ctx, entry->name, NK_TEXT_LEFT);
+    nk_label(ctx, size, NK_TEXT_RIGHT);
+    if(has_previous && change > 0)
+        nk_label_colored(ctx, delta, NK_TEXT_RIGHT, nk_rgb(255, 140, 0));
+    else if(has_previous && change < 0)
+        nk_label_colored(ctx, delta, NK_TEXT_RIGHT, nk_rgb(0, 220, 120));
+    else
+        nk_label(ctx, delta, NK_TEXT_RIGHT);
+}
+
+void editor_panel_size_report(struct nk_context *ctx){
+    if(nk_begin(ctx, "Size Report", nk_rect(screenWidth / 2 - 350, screenHeight / 2 - 275, 700, 550), NK_WINDOW_BORDER|NK_WINDOW_TITLE|NK_WINDOW_MOVABLE|NK_WINDOW_SCALABLE)){
+        editor_size_report_lock();
+
+        char header[256];
+        if(!editor_size_report.valid)
+            snprintf(header, sizeof(header), "No report yet, one is made after every successful build.");
+        else if(!editor_size_report.has_previous)
+            snprintf(header, sizeof(header), "%s (first build of this configuration, no changes to show)", editor_size_report.config);
+        else
+            snprintf(header, sizeof(header), "%s, changes since the previous build", editor_size_report.config);
+
+        nk_layout_row_begin(ctx, NK_DYNAMIC, 25, 3);
+        nk_layout_row_push(ctx, 0.6f);
+        nk_label(ctx, header, NK_TEXT_LEFT);
+        nk_layout_row_push(ctx, 0.25f);
+        nk_checkbox_label(ctx, "Only changes", &size_report_only_changes);
+        nk_layout_row_push(ctx, 0.15f);
+        bool close = nk_button_label(ctx, "Close");
+        nk_layout_row_end(ctx);
+
+        for(int kind = 0; kind < EDITOR_SIZE_NUM_KINDS && editor_size_report.valid; kind++){
+            if(nk_tree_push_id(ctx, NK_TREE_TAB, size_report_titles[kind], kind == EDITOR_SIZE_FILE ? NK_MAXIMIZED : NK_MINIMIZED, kind)){
+                for(int i = 0; i < editor_size_report.num_entries; i++){
+                    const struct editor_size_entry *entry = &editor_size_report.entries[i];
+                    if((int)entry->kind != kind)
+                        continue;
+                    if(size_report_only_changes && entry->previous == entry->bytes)
+                        continue;
+                    size_report_row(ctx, entry, editor_size_report.has_previous);
+                }
+                nk_tree_pop(ctx);
+            }
+        }
+
+        editor_size_report_unlock();
+
+        if(close)
+            remove_ui_component("size report");
+
+        nk_end(ctx);
+    }
+}
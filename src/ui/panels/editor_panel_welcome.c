@@ -585,7 +585,9 @@ void group_projects(struct nk_context *ctx) {
         nk_layout_row_dynamic(ctx, 50, 4);
         ye_h3(nk_label_colored(ctx, "Projects:", NK_TEXT_LEFT, nk_rgb(255, 255, 255)));
 
-        nk_label(ctx, "", NK_TEXT_LEFT);
+        if(nk_button_image_label(ctx, editor_icons.build, "Build All", NK_TEXT_CENTERED)){
+            editor_panel_batch_open();
+        }
 
         if(nk_button_image_label(ctx, editor_icons.style, "New", NK_TEXT_CENTERED)){
             create_project_popup_open = true;